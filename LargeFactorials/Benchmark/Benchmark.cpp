@@ -0,0 +1,190 @@
+/*
+	PROBLEM: Compare how long each factorial method takes to compute N!, and check that they agree.
+
+	USAGE:	Benchmark [-r repeats] [-j threads] [N ...]
+				Computes N! with each method and reports the best time of each, in milliseconds, and how many times faster
+				than the sequential product it is.  N defaults to 1000, 10000, 100000, and 1000000.
+				Then computes C(N, N/2) both ways: from its prime factorization, and as N! / ((N/2)! (N - N/2)!) with a
+				multiplication and a division by reciprocal, and checks that they agree.
+				The sequential product is skipped above SEQUENTIAL_LIMIT, where it takes minutes.
+				-r computes each factorial repeats times and keeps the fastest, for steadier timings on small N.
+				-j runs the product tree and prime swing on this many threads, or one per hardware thread for 0.  Defaults to 1.
+
+	BUILD:	g++ -std=c++17 -O2 -pthread Benchmark.cpp ../BigUnsigned.cpp ../Multiply.cpp ../NTT.cpp ../Divide.cpp ../Decimal.cpp ../Factorial.cpp ../FactorialQueries.cpp ../Combinatorics.cpp
+*/
+
+#include <iostream>		//	for cout
+#include <iomanip>		//	for setw, setprecision
+#include <vector>		//	for vector
+#include <algorithm>	//	for min, max
+#include <chrono>		//	for steady_clock
+#include <cstring>		//	for strcmp
+#include <cstdlib>		//	for strtoul
+#include "../BigUnsigned.h"
+#include "../Multiply.h"
+#include "../Divide.h"
+#include "../Factorial.h"
+#include "../Combinatorics.h"
+using namespace std;
+
+//	N computed when none are named on the command line.
+const unsigned int DEFAULT_N[] = { 1000, 10000, 100000, 1000000 };
+
+//	Largest N the sequential product is timed for.
+const unsigned int SEQUENTIAL_LIMIT = 300000;
+
+//	Methods compared, with the sequential product first as the baseline.
+const FactorialMethod METHODS[] = { SequentialProduct, ProductTree, PrimeSwing };
+const unsigned int METHOD_COUNT = 3;
+
+double TimeFactorial(const unsigned int n, FactorialMethod method, unsigned int numThreads, unsigned int repeats, BigUnsigned& result);
+double TimeBinomial(const unsigned int n, bool byDivision, unsigned int numThreads, unsigned int repeats, LimbVector& result);
+void BinomialByDivision(const unsigned int n, const unsigned int k, unsigned int numThreads, LimbVector& result);
+
+int main(int argc, char* argv[]) {
+	unsigned int repeats = 1;
+	unsigned int numThreads = 1;
+
+	int arg = 1;
+	for (; arg < argc && argv[arg][0] == '-'; ++arg) {
+		if (strcmp(argv[arg], "-r") == 0 && arg + 1 < argc) {
+			repeats = max(static_cast<unsigned int>(strtoul(argv[++arg], nullptr, 10)), 1u);
+		}
+		else if (strcmp(argv[arg], "-j") == 0 && arg + 1 < argc) {
+			numThreads = static_cast<unsigned int>(strtoul(argv[++arg], nullptr, 10));
+		}
+		else {
+			cerr << "Usage: Benchmark [-r repeats] [-j threads] [N ...]" << endl;
+			return 1;
+		}
+	}
+
+	vector<unsigned int> values;
+	for (; arg < argc; ++arg) {
+		values.push_back(static_cast<unsigned int>(strtoul(argv[arg], nullptr, 10)));
+	}
+	if (values.empty()) {
+		values.assign(DEFAULT_N, DEFAULT_N + sizeof(DEFAULT_N) / sizeof(DEFAULT_N[0]));
+	}
+
+	cout << right << setw(10) << "N" << setw(10) << "Limbs" << setw(14) << "Sequential" << setw(14) << "Tree" << setw(10) << "x"
+		 << setw(14) << "Prime swing" << setw(10) << "x" << setw(8) << "Agree" << "\n";
+
+	for (unsigned int n : values) {
+		//	Time every method, checking each result against the first one computed.
+		double times[METHOD_COUNT];
+		BigUnsigned expected;
+		bool agree = true;
+		bool haveExpected = false;
+		for (unsigned int i = 0; i < METHOD_COUNT; ++i) {
+			if (METHODS[i] == SequentialProduct && n > SEQUENTIAL_LIMIT) {
+				times[i] = 0;
+				continue;
+			}
+
+			BigUnsigned result;
+			times[i] = TimeFactorial(n, METHODS[i], numThreads, repeats, result);
+			if (!haveExpected) {
+				expected = result;
+				haveExpected = true;
+			}
+			else if (result.GetLimbs() != expected.GetLimbs()) {
+				agree = false;
+			}
+		}
+
+		//	Output the row, with each faster method's speedup over the sequential product when it was timed.
+		cout << setw(10) << n << setw(10) << expected.GetLimbCount() << fixed << setprecision(2);
+		for (unsigned int i = 0; i < METHOD_COUNT; ++i) {
+			if (times[i] == 0) {
+				cout << setw(14) << "-";
+			}
+			else {
+				cout << setw(14) << times[i];
+			}
+
+			if (i > 0) {
+				if (times[0] > 0 && times[i] > 0) {
+					cout << setw(10) << times[0] / times[i];
+				}
+				else {
+					cout << setw(10) << "-";
+				}
+			}
+		}
+		cout << setw(8) << (agree ? "yes" : "NO") << "\n";
+	}
+
+	cout << "\n" << right << setw(10) << "N" << setw(10) << "Limbs" << setw(14) << "C(N, N/2) div" << setw(14) << "Primes" << setw(10) << "x"
+		 << setw(8) << "Agree" << "\n";
+
+	for (unsigned int n : values) {
+		LimbVector divided;
+		LimbVector factored;
+		double divisionTime = TimeBinomial(n, true, numThreads, repeats, divided);
+		double primesTime = TimeBinomial(n, false, numThreads, repeats, factored);
+
+		cout << setw(10) << n << setw(10) << factored.size() << fixed << setprecision(2) << setw(14) << divisionTime
+			 << setw(14) << primesTime << setw(10) << divisionTime / primesTime << setw(8) << ((divided == factored) ? "yes" : "NO") << "\n";
+	}
+
+	return 0;
+}
+
+//	Returns the fastest of repeats runs of the method, in milliseconds, storing the last answer in "result".
+double TimeFactorial(const unsigned int n, FactorialMethod method, unsigned int numThreads, unsigned int repeats, BigUnsigned& result) {
+	double best = 0;
+	for (unsigned int pass = 0; pass < repeats; ++pass) {
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		Factorial(n, method, numThreads, result);
+		chrono::steady_clock::time_point finish = chrono::steady_clock::now();
+
+		double elapsed = chrono::duration<double, milli>(finish - start).count();
+		best = (pass == 0) ? elapsed : min(best, elapsed);
+	}
+
+	//	Never report zero, which marks a method that wasn't timed.
+	return max(best, 0.001);
+}
+
+//	Returns the fastest of repeats computations of C(n, n/2), in milliseconds, by division or from the primes, storing the
+//	last answer in "result".
+double TimeBinomial(const unsigned int n, bool byDivision, unsigned int numThreads, unsigned int repeats, LimbVector& result) {
+	unsigned int k = n / 2;	//	Intentional integer division.
+	double best = 0;
+	for (unsigned int pass = 0; pass < repeats; ++pass) {
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		if (byDivision) {
+			BinomialByDivision(n, k, numThreads, result);
+		}
+		else {
+			BigUnsigned binomial;
+			Binomial(n, k, numThreads, binomial);
+			result = binomial.GetLimbs();
+		}
+		chrono::steady_clock::time_point finish = chrono::steady_clock::now();
+
+		double elapsed = chrono::duration<double, milli>(finish - start).count();
+		best = (pass == 0) ? elapsed : min(best, elapsed);
+	}
+
+	return max(best, 0.001);
+}
+
+//	The textbook way: n! / (k! (n - k)!).  For k near n/2 the divisor's square is well past n!, as DivideByReciprocal()
+//	needs.
+void BinomialByDivision(const unsigned int n, const unsigned int k, unsigned int numThreads, LimbVector& result) {
+	BigUnsigned numerator;
+	BigUnsigned low;
+	BigUnsigned high;
+	BigUnsigned denominator;
+	Factorial(n, PrimeSwing, numThreads, numerator);
+	Factorial(k, PrimeSwing, numThreads, low);
+	Factorial(n - k, PrimeSwing, numThreads, high);
+	MultiplyInParallel(low, high, numThreads, denominator);
+
+	Reciprocal reciprocal;
+	LimbVector remainder;
+	ComputeReciprocal(denominator.GetLimbs(), reciprocal);
+	DivideByReciprocal(numerator.GetLimbs(), reciprocal, result, remainder);
+}
\ No newline at end of file
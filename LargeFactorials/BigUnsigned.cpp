@@ -0,0 +1,83 @@
+#include <cstdint>	//	for uint64_t
+#include <string>	//	for string
+#include <vector>	//	for vector
+#include <utility>	//	for move
+#include "BigUnsigned.h"
+#include "Decimal.h"
+using namespace std;
+
+BigUnsigned::BigUnsigned(uint64_t value) {
+	if (value != 0) {
+		_limbs.push_back(value);
+	}
+}
+
+BigUnsigned::BigUnsigned(vector<Limb> limbs) : _limbs(move(limbs)) {
+	while (!_limbs.empty() && _limbs.back() == 0) {
+		_limbs.pop_back();
+	}
+}
+
+//	Multiply each limb by factor, carrying the high half of each 128-bit product into the next limb.
+//		The products don't depend on each other, only the additions do, so four limbs at a time have their products
+//		formed first and then added into a chain of add-with-carry instructions.  The carry between limbs is then a single
+//		flag bit rather than a 64-bit value that the next multiply-add has to wait for.
+//		NOTE: AVX2 has no 64 x 64 -> 128-bit multiply, and building one from 32-bit lanes measured slower than this.
+void BigUnsigned::MultiplyBy(uint64_t factor) {
+	if (factor == 0) {
+		_limbs.clear();
+		return;
+	}
+
+	size_t count = _limbs.size();
+	Limb* limbs = _limbs.data();
+	uint64_t high = 0;
+	unsigned char carry = 0;
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		uint64_t low0;
+		uint64_t low1;
+		uint64_t low2;
+		uint64_t low3;
+		uint64_t high0;
+		uint64_t high1;
+		uint64_t high2;
+		uint64_t high3;
+		MultiplyLimbs(limbs[i], factor, low0, high0);
+		MultiplyLimbs(limbs[i + 1], factor, low1, high1);
+		MultiplyLimbs(limbs[i + 2], factor, low2, high2);
+		MultiplyLimbs(limbs[i + 3], factor, low3, high3);
+
+		limbs[i] = AddWithCarry(low0, high, carry);
+		limbs[i + 1] = AddWithCarry(low1, high0, carry);
+		limbs[i + 2] = AddWithCarry(low2, high1, carry);
+		limbs[i + 3] = AddWithCarry(low3, high2, carry);
+		high = high3;
+	}
+
+	//	Can't overflow: the high half of a product is at most 2^64 - 2.
+	high += carry;
+	for (; i < count; ++i) {
+		uint64_t low;
+		uint64_t nextHigh;
+		MultiplyLimbs(limbs[i], factor, low, nextHigh);
+
+		//	Can't overflow: the largest product plus carry is (2^64 - 1)^2 + (2^64 - 1) < 2^128.
+		low += high;
+		nextHigh += (low < high) ? 1 : 0;
+
+		limbs[i] = low;
+		high = nextHigh;
+	}
+
+	if (high != 0) {
+		_limbs.push_back(high);
+	}
+}
+
+//	See ToDecimal() for how the digits are produced.
+string BigUnsigned::ToString() const {
+	string text;
+	ToDecimal(*this, 1, text);
+	return text;
+}
\ No newline at end of file
@@ -0,0 +1,94 @@
+#ifndef BIGUNSIGNED_H
+#define BIGUNSIGNED_H
+#pragma once
+
+#include <cstdint>	//	for uint64_t
+#include <cstddef>	//	for size_t
+#include <string>	//	for string
+#include <vector>	//	for vector
+#if defined(_MSC_VER)
+#include <intrin.h>	//	for _umul128, _udiv128, _addcarry_u64
+#elif defined(__x86_64__)
+#include <immintrin.h>	//	for _addcarry_u64
+#endif
+
+//	Number of bits in each limb.
+const unsigned int LIMB_BITS = 64;
+
+//	Largest power of ten that fits in a limb, and its number of zeros.  Decimal output is produced this many digits at a time.
+const uint64_t DECIMAL_CHUNK = 10000000000000000000ull;
+const unsigned int DECIMAL_CHUNK_DIGITS = 19;
+
+//-------------------------------------------------------------
+//	BigUnsigned class holds an arbitrarily large non-negative integer as 64-bit limbs, least significant first.
+//		Each limb holds about 19 decimal digits, and products of two limbs are formed in 128 bits, so every step of a
+//		multiplication handles 19 digits at once instead of one.
+//		NOTE: the most significant limb is never zero, so zero has no limbs at all.
+class BigUnsigned {
+public:
+	typedef uint64_t Limb;
+
+	//	Create the value zero.
+	BigUnsigned() {};
+	//	Create the value of a single machine word.
+	explicit BigUnsigned(uint64_t value);
+	//	Create a value from its limbs, least significant first.  Leading zero limbs are dropped.
+	explicit BigUnsigned(std::vector<Limb> limbs);
+
+	//	Multiply in place by a single-word factor.
+	void MultiplyBy(uint64_t factor);
+	//	Make room for this many limbs, so growing up to it never reallocates.
+	void Reserve(size_t limbs) { _limbs.reserve(limbs); };
+
+	//	Returns the value in decimal, without leading zeros.
+	std::string ToString() const;
+
+	bool IsZero() const { return _limbs.empty(); };
+	size_t GetLimbCount() const { return _limbs.size(); };
+	const std::vector<Limb>& GetLimbs() const { return _limbs; };
+
+private:
+	std::vector<Limb> _limbs;
+};
+//-------------------------------------------------------------
+
+//	Limb arithmetic functions
+//		MultiplyLimbs() forms the full 128-bit product of two limbs, as its low and high halves.
+//		DivideLimbs() divides the 128-bit value (high, low) by divisor, which must be greater than high.
+//		AddWithCarry() returns a + b + carry, where carry is zero or one, and sets carry to the carry out.
+//		All are inline, since every multiplication loop calls them once per limb.
+inline void MultiplyLimbs(uint64_t a, uint64_t b, uint64_t& low, uint64_t& high) {
+#if defined(_MSC_VER)
+	low = _umul128(a, b, &high);
+#else
+	unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+	low = static_cast<uint64_t>(product);
+	high = static_cast<uint64_t>(product >> LIMB_BITS);
+#endif
+}
+
+inline uint64_t DivideLimbs(uint64_t high, uint64_t low, uint64_t divisor, uint64_t& remainder) {
+#if defined(_MSC_VER)
+	return _udiv128(high, low, divisor, &remainder);
+#else
+	unsigned __int128 dividend = (static_cast<unsigned __int128>(high) << LIMB_BITS) | low;
+	remainder = static_cast<uint64_t>(dividend % divisor);
+	return static_cast<uint64_t>(dividend / divisor);	//	Intentional integer division.
+#endif
+}
+
+inline uint64_t AddWithCarry(uint64_t a, uint64_t b, unsigned char& carry) {
+#if defined(_MSC_VER) || defined(__x86_64__)
+	unsigned long long sum;
+	carry = _addcarry_u64(carry, a, b, &sum);
+	return sum;
+#else
+	uint64_t sum = a + b;
+	unsigned char carryOut = (sum < a) ? 1 : 0;
+	uint64_t total = sum + carry;
+	carry = carryOut | ((total < sum) ? 1 : 0);
+	return total;
+#endif
+}
+
+#endif	//	BIGUNSIGNED_H
\ No newline at end of file
@@ -0,0 +1,233 @@
+#include <cstdint>	//	for uint64_t
+#include <cstddef>	//	for size_t
+#include <vector>	//	for vector
+#include <thread>	//	for thread
+#include <algorithm>	//	for max, min, sort
+#include <cmath>		//	for sqrt
+#include "BigUnsigned.h"
+#include "Multiply.h"
+#include "Factorial.h"
+#include "FactorialQueries.h"
+#include "Combinatorics.h"
+using namespace std;
+
+//	By Kummer's theorem, the exponent of p in C(n, k) is the number of carries when adding k and n - k in base p, which is
+//	what the difference of Legendre counts works out to.
+//		With k the smaller of k and n - k, C(n, k) = n (n - 1) ... (n - k + 1) / k!.  For small k, that window is factored
+//		directly, and k!'s exponents taken off it: every prime up to k divides one of k consecutive factors, so the
+//		window's primes already include all of k!'s.
+void Binomial(const unsigned int n, const unsigned int k, unsigned int numThreads, BigUnsigned& result) {
+	if (k > n) {
+		result = BigUnsigned();
+		return;
+	}
+
+	unsigned int smaller = min(k, n - k);
+	vector<unsigned int> primes;
+	vector<uint64_t> exponents;
+	if (smaller <= n / WINDOW_FRACTION) {	//	Intentional integer division.
+		FactorWindow(n, smaller, primes, exponents);
+		for (size_t i = 0; i < primes.size() && primes[i] <= smaller; ++i) {
+			exponents[i] -= CountPrimeInFactorial(smaller, primes[i]);
+		}
+
+		MultiplyPrimePowers(primes, exponents, numThreads, result);
+		return;
+	}
+
+	SievePrimes(n, primes);
+
+	exponents.resize(primes.size());
+	for (size_t i = 0; i < primes.size(); ++i) {
+		exponents[i] = CountPrimeInFactorial(n, primes[i]) - CountPrimeInFactorial(k, primes[i]) - CountPrimeInFactorial(n - k, primes[i]);
+	}
+
+	MultiplyPrimePowers(primes, exponents, numThreads, result);
+}
+
+//	As with Binomial(), when every count but the largest is small, the multinomial is the window of factors above the
+//	largest count divided by the other counts' factorials, none of which has a prime the window lacks.
+void Multinomial(const vector<unsigned int>& counts, unsigned int numThreads, BigUnsigned& result) {
+	unsigned int n = 0;
+	size_t largest = 0;
+	for (size_t i = 0; i < counts.size(); ++i) {
+		n += counts[i];
+		if (counts[i] > counts[largest]) {
+			largest = i;
+		}
+	}
+
+	vector<unsigned int> primes;
+	vector<uint64_t> exponents;
+	unsigned int rest = counts.empty() ? 0 : n - counts[largest];
+	if (rest <= n / WINDOW_FRACTION) {	//	Intentional integer division.
+		FactorWindow(n, rest, primes, exponents);
+		for (size_t count = 0; count < counts.size(); ++count) {
+			if (count == largest) {
+				continue;
+			}
+			for (size_t i = 0; i < primes.size() && primes[i] <= counts[count]; ++i) {
+				exponents[i] -= CountPrimeInFactorial(counts[count], primes[i]);
+			}
+		}
+
+		MultiplyPrimePowers(primes, exponents, numThreads, result);
+		return;
+	}
+
+	SievePrimes(n, primes);
+
+	exponents.resize(primes.size());
+	for (size_t i = 0; i < primes.size(); ++i) {
+		exponents[i] = CountPrimeInFactorial(n, primes[i]);
+		for (unsigned int count : counts) {
+			exponents[i] -= CountPrimeInFactorial(count, primes[i]);
+		}
+	}
+
+	MultiplyPrimePowers(primes, exponents, numThreads, result);
+}
+
+//	A short run of factors near n has little to gain from factoring, and would need every prime up to n sieved, so it's
+//	multiplied out directly.  Past half of n, the run looks enough like n! for the prime powers to pay off.
+void FallingFactorial(const unsigned int n, const unsigned int k, unsigned int numThreads, BigUnsigned& result) {
+	if (k > n) {
+		result = BigUnsigned();
+		return;
+	}
+	if (numThreads == 0) {
+		numThreads = max(thread::hardware_concurrency(), 1u);
+	}
+
+	if (k < n / 2) {	//	Intentional integer division.
+		if (numThreads > 1) {
+			MultiplyRangeInParallel(static_cast<uint64_t>(n - k) + 1, n, numThreads, result);
+		}
+		else {
+			MultiplyRangeAsTree(static_cast<uint64_t>(n - k) + 1, n, result);
+		}
+		return;
+	}
+
+	vector<unsigned int> primes;
+	SievePrimes(n, primes);
+
+	vector<uint64_t> exponents(primes.size());
+	for (size_t i = 0; i < primes.size(); ++i) {
+		exponents[i] = CountPrimeInFactorial(n, primes[i]) - CountPrimeInFactorial(n - k, primes[i]);
+	}
+
+	MultiplyPrimePowers(primes, exponents, numThreads, result);
+}
+
+//	With m = floor(n / 2), an even n has n!! = 2^m m!, and an odd one has n!! = n! / (n - 1)!! = n! / (2^m m!).
+void DoubleFactorial(const unsigned int n, unsigned int numThreads, BigUnsigned& result) {
+	unsigned int half = n / 2;	//	Intentional integer division.
+	bool even = (n % 2 == 0);
+
+	vector<unsigned int> primes;
+	SievePrimes(n, primes);
+
+	vector<uint64_t> exponents(primes.size());
+	for (size_t i = 0; i < primes.size(); ++i) {
+		uint64_t inHalf = CountPrimeInFactorial(half, primes[i]) + ((primes[i] == 2) ? half : 0);
+		exponents[i] = even ? inHalf : CountPrimeInFactorial(n, primes[i]) - inHalf;
+	}
+
+	MultiplyPrimePowers(primes, exponents, numThreads, result);
+}
+
+//	Factors n (n - 1) ... (n - k + 1) into primes, listed in increasing order with their exponents.
+//		Only the primes up to sqrt(n) are sieved.  Each is divided out of every factor in the window that it divides, and
+//		whatever is left of a factor after that is one prime above sqrt(n), which can recur only in windows wider than it.
+void FactorWindow(const unsigned int n, const unsigned int k, vector<unsigned int>& primes, vector<uint64_t>& exponents) {
+	primes.clear();
+	exponents.clear();
+
+	uint64_t low = static_cast<uint64_t>(n - k) + 1;
+	vector<unsigned int> remaining(k);
+	for (unsigned int i = 0; i < k; ++i) {
+		remaining[i] = static_cast<unsigned int>(low + i);
+	}
+
+	uint64_t root = static_cast<uint64_t>(sqrt(static_cast<double>(n)));
+	while (root * root > n) {
+		--root;
+	}
+	while ((root + 1) * (root + 1) <= n) {
+		++root;
+	}
+
+	vector<unsigned int> small;
+	SievePrimes(static_cast<unsigned int>(root), small);
+
+	for (unsigned int prime : small) {
+		uint64_t exponent = 0;
+		for (uint64_t multiple = (low + prime - 1) / prime * prime; multiple <= n; multiple += prime) {	//	Intentional integer division.
+			unsigned int& factor = remaining[multiple - low];
+			do {
+				factor /= prime;
+				++exponent;
+			} while (factor % prime == 0);
+		}
+
+		if (exponent > 0) {
+			primes.push_back(prime);
+			exponents.push_back(exponent);
+		}
+	}
+
+	vector<unsigned int> large;
+	for (unsigned int factor : remaining) {
+		if (factor > 1) {
+			large.push_back(factor);
+		}
+	}
+	sort(large.begin(), large.end());
+
+	for (size_t i = 0; i < large.size(); ++i) {
+		if (i > 0 && large[i] == large[i - 1]) {
+			++exponents.back();
+		}
+		else {
+			primes.push_back(large[i]);
+			exponents.push_back(1);
+		}
+	}
+}
+
+//	Computes the product of primes[i]^exponents[i].
+//		Small primes can have exponents in the thousands or more, so rather than repeat them, the product is built from
+//		the exponents' bits, top bit first: square what's there, then multiply in the primes whose exponent has the
+//		current bit set, as a product tree.  Each prime costs one word per set bit, and the squarings are balanced.
+void MultiplyPrimePowers(const vector<unsigned int>& primes, const vector<uint64_t>& exponents, unsigned int numThreads, BigUnsigned& result) {
+	if (numThreads == 0) {
+		numThreads = max(thread::hardware_concurrency(), 1u);
+	}
+
+	uint64_t largest = 0;
+	for (uint64_t exponent : exponents) {
+		largest = max(largest, exponent);
+	}
+
+	result = BigUnsigned(1);
+	vector<uint64_t> factors;
+	for (int bit = 63; bit >= 0; --bit) {
+		if ((largest >> bit) == 0) {
+			continue;
+		}
+
+		MultiplyInParallel(result, result, numThreads, result);
+
+		factors.clear();
+		for (size_t i = 0; i < primes.size(); ++i) {
+			if ((exponents[i] >> bit) & 1) {
+				factors.push_back(primes[i]);
+			}
+		}
+
+		BigUnsigned product;
+		MultiplyListAsTree(factors, 0, factors.size(), product);
+		MultiplyInParallel(result, product, numThreads, result);
+	}
+}
\ No newline at end of file
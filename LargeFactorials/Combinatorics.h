@@ -0,0 +1,31 @@
+#ifndef COMBINATORICS_H
+#define COMBINATORICS_H
+#pragma once
+
+#include <cstdint>	//	for uint64_t
+#include <vector>	//	for vector
+#include "BigUnsigned.h"
+
+//	Binomial() and Multinomial() factor only the run of factors above their largest part when that run is at most
+//	1 / WINDOW_FRACTION of n, which needs the primes up to sqrt(n) rather than every prime up to n.
+const unsigned int WINDOW_FRACTION = 4;
+
+//	Interface functions
+//		Each builds its answer from its prime factorization: the exponent of each prime comes from Legendre's formula
+//		applied to the factorials it's a quotient of, and only the prime powers that survive are multiplied out.  No
+//		factorial bigger than the answer is formed, and nothing is divided.
+//		numThreads is the number of threads to use, or 0 to use one per hardware thread.
+//		Computes C(n, k) = n! / (k! (n - k)!), which is zero for k > n.
+void Binomial(const unsigned int n, const unsigned int k, unsigned int numThreads, BigUnsigned& result);
+//		Computes (k1 + k2 + ...)! / (k1! k2! ...) for the counts k1, k2, ..., whose sum must fit in an unsigned int.
+void Multinomial(const std::vector<unsigned int>& counts, unsigned int numThreads, BigUnsigned& result);
+//		Computes n (n - 1) ... (n - k + 1) = n! / (n - k)!, which is zero for k > n.
+void FallingFactorial(const unsigned int n, const unsigned int k, unsigned int numThreads, BigUnsigned& result);
+//		Computes n!! = n (n - 2) (n - 4) ..., down to one or two.
+void DoubleFactorial(const unsigned int n, unsigned int numThreads, BigUnsigned& result);
+
+//	Helper functions
+void FactorWindow(const unsigned int n, const unsigned int k, std::vector<unsigned int>& primes, std::vector<uint64_t>& exponents);
+void MultiplyPrimePowers(const std::vector<unsigned int>& primes, const std::vector<uint64_t>& exponents, unsigned int numThreads, BigUnsigned& result);
+
+#endif	//	COMBINATORICS_H
\ No newline at end of file
@@ -0,0 +1,132 @@
+#include <cstdint>	//	for uint64_t
+#include <string>	//	for string
+#include <vector>	//	for vector
+#include <thread>	//	for thread
+#include <algorithm>	//	for max
+#include "BigUnsigned.h"
+#include "Multiply.h"
+#include "Divide.h"
+#include "Decimal.h"
+using namespace std;
+
+void ToDecimal(const BigUnsigned& value, unsigned int numThreads, string& text) {
+	if (numThreads == 0) {
+		numThreads = max(thread::hardware_concurrency(), 1u);
+	}
+
+	const LimbVector& limbs = value.GetLimbs();
+	if (limbs.empty()) {
+		text = "0";
+		return;
+	}
+
+	//	value has at most bits * log10(2) + 1 digits; 0.30103 is just over log10(2), so this never comes up short.
+	uint64_t bits = static_cast<uint64_t>(limbs.size()) * LIMB_BITS - CountLeadingZeros(limbs.back());
+	size_t chunks = static_cast<size_t>((bits * 30103 / 100000 + 1) / DECIMAL_CHUNK_DIGITS + 1);	//	Intentional integer division.
+
+	//	Halve the chunk count, rounding up, until it's short enough to convert directly.  Rounding up keeps each level's
+	//	values below the square of the power they're split by, as DivideByReciprocal needs.
+	vector<size_t> counts;
+	for (size_t count = chunks; count > DECIMAL_SPLIT_THRESHOLD; ) {
+		count = (count + 1) / 2;	//	Intentional integer division.
+		counts.push_back(count);
+	}
+
+	//	Build the powers from the smallest up: each is the square of the next smaller one, divided by DECIMAL_CHUNK once
+	//	when its count is odd.
+	vector<DecimalSplit> splits(counts.size());
+	LimbVector power;
+	for (size_t level = counts.size(); level-- > 0; ) {
+		if (level + 1 == counts.size()) {
+			BigUnsigned smallest(1);
+			for (size_t i = 0; i < counts[level]; ++i) {
+				smallest.MultiplyBy(DECIMAL_CHUNK);
+			}
+			power = smallest.GetLimbs();
+		}
+		else {
+			LimbVector square;
+			MultiplyLimbVectors(power, power, square);
+			if (counts[level] % 2 == 1) {
+				LimbVector remainder;
+				LimbVector chunk(1, DECIMAL_CHUNK);
+				DivideSchoolbook(square, chunk, power, remainder);
+			}
+			else {
+				power = square;
+			}
+		}
+
+		splits[level].lowChunks = counts[level];
+		ComputeReciprocal(power, splits[level].power);
+	}
+
+	//	Write every place, then drop the leading zeros.
+	text.assign(chunks * DECIMAL_CHUNK_DIGITS, '0');
+	WriteDigits(limbs, splits, 0, chunks, numThreads, &text[0]);
+	text.erase(0, text.find_first_not_of('0'));
+}
+
+//	Writes value, which is below 10^(19 * chunks), as exactly 19 * chunks digits, with leading zeros.
+//	The two halves of a split write to separate places, so with more than one thread they're written side by side, each
+//	with a share of the threads.
+void WriteDigits(const LimbVector& value, const vector<DecimalSplit>& splits, size_t level, size_t chunks, unsigned int numThreads, char* digits) {
+	if (level == splits.size() || value.size() < DECIMAL_SPLIT_THRESHOLD) {
+		WriteDigitsByChunks(value, chunks, digits);
+		return;
+	}
+
+	//	Already short enough for the next level down.
+	const DecimalSplit& split = splits[level];
+	if (chunks <= split.lowChunks) {
+		WriteDigits(value, splits, level + 1, chunks, numThreads, digits);
+		return;
+	}
+
+	//	value = high * 10^(19 * lowChunks) + low.
+	LimbVector high;
+	LimbVector low;
+	DivideByReciprocal(value, split.power, high, low);
+
+	size_t highChunks = chunks - split.lowChunks;
+	char* lowDigits = digits + highChunks * DECIMAL_CHUNK_DIGITS;
+	if (numThreads > 1) {
+		unsigned int highThreads = numThreads / 2;	//	Intentional integer division.
+		thread worker(RunDigitsWorker, &high, &splits, level + 1, highChunks, highThreads, digits);
+		WriteDigits(low, splits, level + 1, split.lowChunks, numThreads - highThreads, lowDigits);
+		worker.join();
+	}
+	else {
+		WriteDigits(high, splits, level + 1, highChunks, 1, digits);
+		WriteDigits(low, splits, level + 1, split.lowChunks, 1, lowDigits);
+	}
+}
+
+void RunDigitsWorker(const LimbVector* value, const vector<DecimalSplit>* splits, size_t level, size_t chunks, unsigned int numThreads, char* digits) {
+	WriteDigits(*value, *splits, level, chunks, numThreads, digits);
+}
+
+//	Peels off DECIMAL_CHUNK_DIGITS digits at a time by dividing by DECIMAL_CHUNK, filling the chunks from the right.
+//	Places the value doesn't reach are left as they were, which is zero.
+void WriteDigitsByChunks(const LimbVector& value, size_t chunks, char* digits) {
+	LimbVector quotient = value;
+	char* end = digits + chunks * DECIMAL_CHUNK_DIGITS;
+	while (!quotient.empty()) {
+		uint64_t remainder = 0;
+		for (size_t i = quotient.size(); i-- > 0; ) {
+			quotient[i] = DivideLimbs(remainder, quotient[i], DECIMAL_CHUNK, remainder);
+		}
+		TrimLimbs(quotient);
+
+		end -= DECIMAL_CHUNK_DIGITS;
+		WriteChunk(remainder, end);
+	}
+}
+
+//	Writes chunk as exactly DECIMAL_CHUNK_DIGITS digits, with leading zeros.
+void WriteChunk(uint64_t chunk, char* digits) {
+	for (unsigned int i = DECIMAL_CHUNK_DIGITS; i-- > 0; ) {
+		digits[i] = static_cast<char>('0' + chunk % 10);
+		chunk /= 10;	//	Intentional integer division.
+	}
+}
\ No newline at end of file
@@ -0,0 +1,37 @@
+#ifndef DECIMAL_H
+#define DECIMAL_H
+#pragma once
+
+#include <cstddef>	//	for size_t
+#include <string>	//	for string
+#include <vector>	//	for vector
+#include "BigUnsigned.h"
+#include "Multiply.h"
+#include "Divide.h"
+
+//	Values shorter than this many limbs, or this many DECIMAL_CHUNKs, are converted by dividing out DECIMAL_CHUNK one
+//	chunk at a time.
+const size_t DECIMAL_SPLIT_THRESHOLD = 48;
+
+//	One level of the conversion: values at this level are split into the low lowChunks chunks and the rest by dividing by
+//	power = 10^(19 * lowChunks).
+struct DecimalSplit {
+	size_t lowChunks;
+	Reciprocal power;
+};
+
+//	Interface functions
+//		Writes value in decimal, without leading zeros, into text.
+//		Long values are split about in half by a power of ten and each half converted on its own, down to pieces short
+//		enough to convert chunk by chunk.  The divisions use precomputed reciprocals, so the whole conversion costs a few
+//		multiplications of each size rather than time quadratic in the length.
+//		numThreads is the number of threads to use, or 0 to use one per hardware thread.
+void ToDecimal(const BigUnsigned& value, unsigned int numThreads, std::string& text);
+
+//	Helper functions
+void WriteDigits(const LimbVector& value, const std::vector<DecimalSplit>& splits, size_t level, size_t chunks, unsigned int numThreads, char* digits);
+void RunDigitsWorker(const LimbVector* value, const std::vector<DecimalSplit>* splits, size_t level, size_t chunks, unsigned int numThreads, char* digits);
+void WriteDigitsByChunks(const LimbVector& value, size_t chunks, char* digits);
+void WriteChunk(uint64_t chunk, char* digits);
+
+#endif	//	DECIMAL_H
\ No newline at end of file
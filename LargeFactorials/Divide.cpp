@@ -0,0 +1,261 @@
+#include <cstdint>	//	for uint64_t
+#include <vector>	//	for vector
+#include <utility>	//	for move
+#include "BigUnsigned.h"
+#include "Multiply.h"
+#include "Divide.h"
+using namespace std;
+
+void ComputeReciprocal(const LimbVector& divisor, Reciprocal& reciprocal) {
+	reciprocal.divisor = divisor;
+	reciprocal.shift = CountLeadingZeros(divisor.back());
+	ShiftLimbsLeft(divisor, reciprocal.shift, reciprocal.normalized);
+	ComputeInverse(reciprocal.normalized, reciprocal.inverse);
+}
+
+//	Only the top limbs of the dividend matter to the quotient estimate
+//		floor(floor(shifted / B^(m - 1)) * inverse / B^(m + 1))
+//	which is within a few of the true quotient, since the inverse is within a few of B^(2m) / normalized and shifted is
+//	below B^(2m).  The estimate is then corrected in whichever direction it's off.
+void DivideByReciprocal(const LimbVector& dividend, const Reciprocal& reciprocal, LimbVector& quotient, LimbVector& remainder) {
+	size_t limbs = reciprocal.normalized.size();
+
+	LimbVector shifted;
+	ShiftLimbsLeft(dividend, reciprocal.shift, shifted);
+	DropLowLimbs(shifted, limbs - 1);
+	MultiplyLimbVectors(shifted, reciprocal.inverse, quotient);
+	DropLowLimbs(quotient, limbs + 1);
+
+	LimbVector product;
+	MultiplyLimbVectors(quotient, reciprocal.divisor, product);
+
+	LimbVector one(1, 1);
+	while (CompareLimbs(product, dividend) > 0) {
+		SubtractLimbs(quotient, one);
+		SubtractLimbs(product, reciprocal.divisor);
+	}
+
+	remainder = dividend;
+	SubtractLimbs(remainder, product);
+	while (CompareLimbs(remainder, reciprocal.divisor) >= 0) {
+		SubtractLimbs(remainder, reciprocal.divisor);
+		AddLimbsAt(quotient, one, 0);
+	}
+}
+
+//	Knuth's Algorithm D: each quotient limb is estimated from the top two limbs of what's left of the dividend and the top
+//	limb of the divisor, corrected with the divisor's second limb, and multiplied back out and subtracted.  With the divisor
+//	normalized, the estimate is at most two too large, and adding back is rarely needed.
+void DivideSchoolbook(const LimbVector& dividend, const LimbVector& divisor, LimbVector& quotient, LimbVector& remainder) {
+	if (CompareLimbs(dividend, divisor) < 0) {
+		quotient.clear();
+		remainder = dividend;
+		return;
+	}
+
+	if (divisor.size() == 1) {
+		quotient.assign(dividend.size(), 0);
+		uint64_t rest = 0;
+		for (size_t i = dividend.size(); i-- > 0; ) {
+			quotient[i] = DivideLimbs(rest, dividend[i], divisor[0], rest);
+		}
+		TrimLimbs(quotient);
+		remainder.assign(1, rest);
+		TrimLimbs(remainder);
+		return;
+	}
+
+	unsigned int shift = CountLeadingZeros(divisor.back());
+	LimbVector v;
+	LimbVector u;
+	ShiftLimbsLeft(divisor, shift, v);
+	ShiftLimbsLeft(dividend, shift, u);
+	u.resize(dividend.size() + 1, 0);
+
+	size_t n = v.size();
+	size_t m = u.size() - n;
+	quotient.assign(m, 0);
+
+	for (size_t j = m; j-- > 0; ) {
+		//	Estimate the quotient limb from the top two limbs, then correct it with the next limb of each.
+		uint64_t estimate;
+		uint64_t rest;
+		bool restOverflowed = false;
+		if (u[j + n] >= v[n - 1]) {
+			estimate = UINT64_MAX;
+			rest = u[j + n - 1] + v[n - 1];
+			restOverflowed = rest < v[n - 1];
+		}
+		else {
+			estimate = DivideLimbs(u[j + n], u[j + n - 1], v[n - 1], rest);
+		}
+
+		while (!restOverflowed) {
+			uint64_t low;
+			uint64_t high;
+			MultiplyLimbs(estimate, v[n - 2], low, high);
+			if (high < rest || (high == rest && low <= u[j + n - 2])) {
+				break;
+			}
+
+			--estimate;
+			rest += v[n - 1];
+			restOverflowed = rest < v[n - 1];
+		}
+
+		//	Subtract estimate * v from the top n + 1 limbs.
+		uint64_t carry = 0;
+		uint64_t borrow = 0;
+		for (size_t i = 0; i < n; ++i) {
+			uint64_t low;
+			uint64_t high;
+			MultiplyLimbs(estimate, v[i], low, high);
+			low += carry;
+			high += (low < carry) ? 1 : 0;
+
+			uint64_t difference = u[i + j] - low;
+			uint64_t nextBorrow = (u[i + j] < low) ? 1 : 0;
+			nextBorrow += (difference < borrow) ? 1 : 0;
+			u[i + j] = difference - borrow;
+
+			borrow = nextBorrow;
+			carry = high;
+		}
+
+		uint64_t difference = u[j + n] - carry;
+		uint64_t nextBorrow = (u[j + n] < carry) ? 1 : 0;
+		nextBorrow += (difference < borrow) ? 1 : 0;
+		u[j + n] = difference - borrow;
+
+		//	The estimate was one too large: add the divisor back.
+		if (nextBorrow != 0) {
+			--estimate;
+			carry = 0;
+			for (size_t i = 0; i < n; ++i) {
+				uint64_t sum = u[i + j] + carry;
+				carry = (sum < carry) ? 1 : 0;
+				sum += v[i];
+				carry += (sum < v[i]) ? 1 : 0;
+				u[i + j] = sum;
+			}
+			u[j + n] += carry;
+		}
+
+		quotient[j] = estimate;
+	}
+
+	TrimLimbs(quotient);
+	u.resize(n);
+	ShiftLimbsRight(u, shift, remainder);
+}
+
+//	Computes inverse, within a few of B^(2m) / normalized, for an m-limb normalized divisor.
+//		Long divisors start from the inverse of their top h limbs, a little over half, which is good to about h limbs, and
+//		take one Newton step, x' = x + x * (B^(2m) - normalized * x) / B^(2m), which doubles that.  Since the starting point
+//		is the top inverse shifted up by m - h limbs, and only the top of the error term can reach the result, every
+//		multiplication in the step is about half the divisor's length.
+void ComputeInverse(const LimbVector& normalized, LimbVector& inverse) {
+	size_t limbs = normalized.size();
+
+	if (limbs < NEWTON_INVERSE_THRESHOLD) {
+		LimbVector power(2 * limbs + 1, 0);
+		power[2 * limbs] = 1;
+
+		LimbVector remainder;
+		DivideSchoolbook(power, normalized, inverse, remainder);
+		return;
+	}
+
+	size_t low = limbs / 2 - 1;	//	Intentional integer division.
+	LimbVector top(normalized.begin() + low, normalized.end());
+	LimbVector topInverse;
+	ComputeInverse(top, topInverse);
+
+	//	The starting point is x = topInverse * B^low, so the error B^(2m) - normalized * x is B^low times this one.
+	LimbVector power(2 * limbs - low + 1, 0);
+	power[2 * limbs - low] = 1;
+
+	LimbVector product;
+	MultiplyLimbVectors(normalized, topInverse, product);
+	bool tooLarge = CompareLimbs(product, power) > 0;
+
+	LimbVector error;
+	if (tooLarge) {
+		error = move(product);
+		SubtractLimbs(error, power);
+	}
+	else {
+		error = move(power);
+		SubtractLimbs(error, product);
+	}
+
+	//	x * B^low * error / B^(2m) = topInverse * error / B^(2h).  Dropping all but the top of the error first costs less than
+	//	one in the result.
+	size_t high = limbs - low;
+	LimbVector correction;
+	DropLowLimbs(error, high - 1);
+	MultiplyLimbVectors(topInverse, error, correction);
+	DropLowLimbs(correction, high + 1);
+
+	inverse.assign(low, 0);
+	inverse.insert(inverse.end(), topInverse.begin(), topInverse.end());
+	if (tooLarge) {
+		SubtractLimbs(inverse, correction);
+	}
+	else {
+		AddLimbsAt(inverse, correction, 0);
+	}
+}
+
+//	Shifts value up by fewer than LIMB_BITS bits.
+void ShiftLimbsLeft(const LimbVector& value, unsigned int bits, LimbVector& shifted) {
+	if (bits == 0) {
+		shifted = value;
+		return;
+	}
+
+	shifted.assign(value.size() + 1, 0);
+	for (size_t i = 0; i < value.size(); ++i) {
+		shifted[i] |= value[i] << bits;
+		shifted[i + 1] = value[i] >> (LIMB_BITS - bits);
+	}
+	TrimLimbs(shifted);
+}
+
+//	Shifts value down by fewer than LIMB_BITS bits.
+void ShiftLimbsRight(const LimbVector& value, unsigned int bits, LimbVector& shifted) {
+	if (bits == 0) {
+		shifted = value;
+		TrimLimbs(shifted);
+		return;
+	}
+
+	shifted.assign(value.size(), 0);
+	for (size_t i = 0; i < value.size(); ++i) {
+		shifted[i] = value[i] >> bits;
+		if (i + 1 < value.size()) {
+			shifted[i] |= value[i + 1] << (LIMB_BITS - bits);
+		}
+	}
+	TrimLimbs(shifted);
+}
+
+//	Divides value by B^count, discarding the remainder.
+void DropLowLimbs(LimbVector& value, size_t count) {
+	if (count >= value.size()) {
+		value.clear();
+		return;
+	}
+	value.erase(value.begin(), value.begin() + count);
+}
+
+//	Returns the number of zero bits above the highest set bit of a non-zero limb.
+unsigned int CountLeadingZeros(uint64_t limb) {
+#if defined(_MSC_VER)
+	unsigned long index;
+	_BitScanReverse64(&index, limb);
+	return 63 - index;
+#else
+	return __builtin_clzll(limb);
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,38 @@
+#ifndef DIVIDE_H
+#define DIVIDE_H
+#pragma once
+
+#include <cstddef>	//	for size_t
+#include "BigUnsigned.h"
+#include "Multiply.h"
+
+//	Divisors shorter than this many limbs are inverted by schoolbook long division; longer ones by Newton's iteration.
+const size_t NEWTON_INVERSE_THRESHOLD = 64;
+
+//	A divisor prepared for dividing many numbers by it with multiplications alone (Barrett reduction).
+//		The divisor is shifted left until its top bit is set, and inverse is within a few of B^(2 * limbs) / normalized, with B = 2^64.
+//		Shifting both sides of a division by the same amount leaves the quotient unchanged, and a normalized divisor
+//		makes the inverse accurate enough that the quotient it gives is never more than a few off.
+struct Reciprocal {
+	LimbVector divisor;
+	LimbVector normalized;
+	LimbVector inverse;
+	unsigned int shift;
+};
+
+//	Interface functions
+//		Prepares reciprocal for dividing by divisor, which must not be zero.
+void ComputeReciprocal(const LimbVector& divisor, Reciprocal& reciprocal);
+//		Divides dividend by the reciprocal's divisor.  dividend must be below the divisor squared.
+void DivideByReciprocal(const LimbVector& dividend, const Reciprocal& reciprocal, LimbVector& quotient, LimbVector& remainder);
+//		Divides dividend by divisor, which must not be zero, by long division.  Quadratic; meant for short divisors.
+void DivideSchoolbook(const LimbVector& dividend, const LimbVector& divisor, LimbVector& quotient, LimbVector& remainder);
+
+//	Helper functions
+void ComputeInverse(const LimbVector& normalized, LimbVector& inverse);
+void ShiftLimbsLeft(const LimbVector& value, unsigned int bits, LimbVector& shifted);
+void ShiftLimbsRight(const LimbVector& value, unsigned int bits, LimbVector& shifted);
+void DropLowLimbs(LimbVector& value, size_t count);
+unsigned int CountLeadingZeros(uint64_t limb);
+
+#endif	//	DIVIDE_H
\ No newline at end of file
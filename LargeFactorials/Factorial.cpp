@@ -0,0 +1,253 @@
+#include <cstdint>	//	for uint64_t, UINT64_MAX
+#include <cstddef>	//	for size_t
+#include <vector>	//	for vector
+#include <atomic>	//	for atomic
+#include <thread>	//	for thread
+#include <algorithm>	//	for min, max
+#include <utility>	//	for move
+#include <cmath>	//	for lgamma, log
+#include "BigUnsigned.h"
+#include "Multiply.h"
+#include "Factorial.h"
+using namespace std;
+
+void Factorial(const unsigned int n, FactorialMethod method, unsigned int numThreads, BigUnsigned& result) {
+	if (numThreads == 0) {
+		numThreads = max(thread::hardware_concurrency(), 1u);
+	}
+
+	//	Factorial: 1 x 2 x ... x n-1 x n
+	switch (method) {
+		case SequentialProduct:
+			MultiplyRangeSequentially(2, n, result);
+			break;
+		case ProductTree:
+			if (numThreads > 1) {
+				MultiplyRangeInParallel(2, n, numThreads, result);
+			}
+			else {
+				MultiplyRangeAsTree(2, n, result);
+			}
+			break;
+		case PrimeSwing: {
+			vector<unsigned int> primes;
+			SievePrimes(n, primes);
+			PrimeSwingFactorial(n, primes, numThreads, result);
+			break;
+		}
+	}
+}
+
+//	Consecutive factors are gathered into one 64-bit word for as long as their product fits, so the big number
+//	is only multiplied once per word rather than once per factor.  Its final size is reserved up front, so it never
+//	reallocates as it grows.
+void MultiplyRangeSequentially(uint64_t low, uint64_t high, BigUnsigned& product) {
+	product = BigUnsigned(1);
+	product.Reserve(EstimateRangeLimbs(low, high));
+
+	uint64_t factor = 1;
+	for (uint64_t curN = low; curN <= high; ++curN) {
+		if (factor > UINT64_MAX / curN) {
+			product.MultiplyBy(factor);
+			factor = 1;
+		}
+		factor *= curN;
+	}
+
+	product.MultiplyBy(factor);
+}
+
+//	Returns a little more than the number of limbs in low * (low + 1) * ... * high.
+//		log(high! / (low - 1)!) comes from log-gamma, which is Stirling's series at any size that matters, and is far more
+//		accurate than the two limbs of slack added to it.
+size_t EstimateRangeLimbs(uint64_t low, uint64_t high) {
+	if (high < low) {
+		return 1;
+	}
+
+	double bits = (lgamma(static_cast<double>(high) + 1) - lgamma(static_cast<double>(max<uint64_t>(low, 1)))) / log(2.0);
+	return static_cast<size_t>(bits / LIMB_BITS) + 2;
+}
+
+//	Splitting the range in half keeps the two sub-products about the same size, so the multiplications near the root,
+//	which do nearly all of the work, are balanced enough for Karatsuba and Toom-3 to pay off.
+void MultiplyRangeAsTree(uint64_t low, uint64_t high, BigUnsigned& product) {
+	if (high < low || high - low < PRODUCT_TREE_LEAF) {
+		MultiplyRangeSequentially(low, high, product);
+		return;
+	}
+
+	uint64_t middle = low + (high - low) / 2;	//	Intentional integer division.
+
+	BigUnsigned upper;
+	MultiplyRangeAsTree(low, middle, product);
+	MultiplyRangeAsTree(middle + 1, high, upper);
+	Multiply(product, upper, product);
+}
+
+//	Splits the range into chunks, which the threads multiply out as product trees of their own, then multiplies neighbouring
+//	products together, a round at a time, until one is left.  Once a round has fewer products than there are threads,
+//	the threads left over go to splitting each multiplication.
+void MultiplyRangeInParallel(uint64_t low, uint64_t high, unsigned int numThreads, BigUnsigned& product) {
+	uint64_t count = (high >= low) ? high - low + 1 : 0;
+	uint64_t chunks = min<uint64_t>(static_cast<uint64_t>(numThreads) * CHUNKS_PER_THREAD, count / PRODUCT_TREE_LEAF);
+	if (chunks < 2) {
+		MultiplyRangeAsTree(low, high, product);
+		return;
+	}
+
+	//	Chunk i covers low + bounds[i] through low + bounds[i + 1] - 1.
+	vector<uint64_t> bounds;
+	for (uint64_t i = 0; i <= chunks; ++i) {
+		bounds.push_back(low + count * i / chunks);
+	}
+
+	vector<BigUnsigned> products(chunks);
+	atomic<size_t> next(0);
+	vector<thread> workers;
+	for (unsigned int workerID = 0; workerID < numThreads; ++workerID) {
+		workers.push_back(thread(RunChunkWorker, &next, &bounds, &products));
+	}
+	for (thread& worker : workers) {
+		worker.join();
+	}
+
+	while (products.size() > 1) {
+		size_t pairs = products.size() / 2;	//	Intentional integer division.
+		unsigned int threadsPerMultiply = max(numThreads / static_cast<unsigned int>(min<size_t>(pairs, numThreads)), 1u);
+
+		vector<BigUnsigned> merged((products.size() + 1) / 2);
+		if (products.size() % 2 == 1) {
+			merged.back() = move(products.back());
+		}
+
+		next = 0;
+		workers.clear();
+		for (unsigned int workerID = 0; workerID < min<size_t>(pairs, numThreads); ++workerID) {
+			workers.push_back(thread(RunMergeWorker, &next, &products, threadsPerMultiply, &merged));
+		}
+		for (thread& worker : workers) {
+			worker.join();
+		}
+
+		products = move(merged);
+	}
+
+	product = move(products[0]);
+}
+
+//	Multiplies out chunks until none are left.
+void RunChunkWorker(atomic<size_t>* next, const vector<uint64_t>* bounds, vector<BigUnsigned>* products) {
+	for (;;) {
+		size_t index = next->fetch_add(1);
+		if (index >= products->size()) {
+			return;
+		}
+
+		MultiplyRangeAsTree((*bounds)[index], (*bounds)[index + 1] - 1, (*products)[index]);
+	}
+}
+
+//	Multiplies pairs of neighbouring products until none are left.  An unpaired last product has already been moved over.
+void RunMergeWorker(atomic<size_t>* next, const vector<BigUnsigned>* products, unsigned int threadsPerMultiply, vector<BigUnsigned>* merged) {
+	size_t pairs = products->size() / 2;	//	Intentional integer division.
+	for (;;) {
+		size_t index = next->fetch_add(1);
+		if (index >= pairs) {
+			return;
+		}
+
+		MultiplyInParallel((*products)[2 * index], (*products)[2 * index + 1], threadsPerMultiply, (*merged)[index]);
+	}
+}
+
+//	Same as MultiplyRangeSequentially(), over a list of factors instead of a range.
+void MultiplyListSequentially(const vector<uint64_t>& factors, size_t begin, size_t end, BigUnsigned& product) {
+	product = BigUnsigned(1);
+
+	uint64_t factor = 1;
+	for (size_t i = begin; i < end; ++i) {
+		if (factor > UINT64_MAX / factors[i]) {
+			product.MultiplyBy(factor);
+			factor = 1;
+		}
+		factor *= factors[i];
+	}
+
+	product.MultiplyBy(factor);
+}
+
+//	Same as MultiplyRangeAsTree(), over a list of factors instead of a range.
+void MultiplyListAsTree(const vector<uint64_t>& factors, size_t begin, size_t end, BigUnsigned& product) {
+	if (end - begin <= PRODUCT_TREE_LEAF) {
+		MultiplyListSequentially(factors, begin, end, product);
+		return;
+	}
+
+	size_t middle = begin + (end - begin) / 2;	//	Intentional integer division.
+
+	BigUnsigned upper;
+	MultiplyListAsTree(factors, begin, middle, product);
+	MultiplyListAsTree(factors, middle, end, upper);
+	Multiply(product, upper, product);
+}
+
+//	n! = ((n/2)!)^2 * swing(n), where swing(n) = n! / ((n/2)!)^2 is the swinging factorial.
+//		Each level does one big squaring and one product of primes, instead of the product of every integer from n/2 to n,
+//		and the squarings shrink by half at each level down.  With more than one thread, the big multiplications at the
+//		top levels are split among them.
+void PrimeSwingFactorial(const unsigned int n, const vector<unsigned int>& primes, unsigned int numThreads, BigUnsigned& result) {
+	if (n < PRIME_SWING_BASE) {
+		MultiplyRangeSequentially(2, n, result);
+		return;
+	}
+
+	PrimeSwingFactorial(n / 2, primes, numThreads, result);	//	Intentional integer division.
+	MultiplyInParallel(result, result, numThreads, result);
+
+	BigUnsigned swing;
+	Swing(n, primes, swing);
+	MultiplyInParallel(result, swing, numThreads, result);
+}
+
+//	The exponent of prime p in swing(n) is the number of k for which floor(n / p^k) is odd, and p raised to it never
+//	exceeds n, so each prime contributes a single word.  The words are then multiplied as a product tree.
+void Swing(const unsigned int n, const vector<unsigned int>& primes, BigUnsigned& result) {
+	vector<uint64_t> factors;
+	for (size_t i = 0; i < primes.size() && primes[i] <= n; ++i) {
+		unsigned int prime = primes[i];
+
+		uint64_t power = 1;
+		for (unsigned int quotient = n / prime; quotient > 0; quotient /= prime) {	//	Intentional integer division.
+			if (quotient & 1) {
+				power *= prime;
+			}
+		}
+
+		if (power > 1) {
+			factors.push_back(power);
+		}
+	}
+
+	MultiplyListAsTree(factors, 0, factors.size(), result);
+}
+
+//	Sieve of Eratosthenes.  Fills primes with every prime up to n, in increasing order.
+void SievePrimes(const unsigned int n, vector<unsigned int>& primes) {
+	primes.clear();
+	if (n < 2) {
+		return;
+	}
+
+	vector<bool> composite(static_cast<size_t>(n) + 1, false);
+	for (uint64_t i = 2; i <= n; ++i) {
+		if (composite[i]) {
+			continue;
+		}
+
+		primes.push_back(static_cast<unsigned int>(i));
+		for (uint64_t multiple = i * i; multiple <= n; multiple += i) {
+			composite[multiple] = true;
+		}
+	}
+}
\ No newline at end of file
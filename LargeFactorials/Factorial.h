@@ -0,0 +1,51 @@
+#ifndef FACTORIAL_H
+#define FACTORIAL_H
+#pragma once
+
+#include <cstdint>	//	for uint64_t
+#include <cstddef>	//	for size_t
+#include <vector>	//	for vector
+#include <atomic>	//	for atomic
+#include "BigUnsigned.h"
+
+//	Ranges of at most this many factors are multiplied out one word at a time at the leaves of the product tree.
+const uint64_t PRODUCT_TREE_LEAF = 32;
+
+//	The parallel product tree splits the range into this many chunks per thread, so a thread that finishes early can take
+//	another chunk instead of waiting on the slowest one.
+const unsigned int CHUNKS_PER_THREAD = 4;
+
+//	The prime-swing recursion stops at n below this, where the factorial is a single word.
+const unsigned int PRIME_SWING_BASE = 21;
+
+//	How the factors of n! are multiplied together.
+enum FactorialMethod {
+	SequentialProduct,	//	Multiply the running product by one word of factors at a time.  Quadratic in the result size.
+	ProductTree,		//	Multiply the products of the two halves of the range, recursively, so operands stay balanced.
+	PrimeSwing			//	Luschny's recursion n! = ((n/2)!)^2 * swing(n), with swing(n) built from its prime factorization.
+};
+
+//	Interface functions
+//		Computes n factorial, storing the answer in "result".
+//		numThreads is the number of threads to use, or 0 to use one per hardware thread.  The sequential product always uses one.
+void Factorial(const unsigned int n, FactorialMethod method, unsigned int numThreads, BigUnsigned& result);
+
+//	Helper functions
+//		Each computes the product of every integer from low to high inclusive, which is one if the range is empty.
+void MultiplyRangeSequentially(uint64_t low, uint64_t high, BigUnsigned& product);
+void MultiplyRangeAsTree(uint64_t low, uint64_t high, BigUnsigned& product);
+void MultiplyRangeInParallel(uint64_t low, uint64_t high, unsigned int numThreads, BigUnsigned& product);
+size_t EstimateRangeLimbs(uint64_t low, uint64_t high);
+
+void RunChunkWorker(std::atomic<size_t>* next, const std::vector<uint64_t>* bounds, std::vector<BigUnsigned>* products);
+void RunMergeWorker(std::atomic<size_t>* next, const std::vector<BigUnsigned>* products, unsigned int threadsPerMultiply, std::vector<BigUnsigned>* merged);
+
+//		Each computes the product of factors[begin] through factors[end - 1], which is one if the list is empty.
+void MultiplyListSequentially(const std::vector<uint64_t>& factors, size_t begin, size_t end, BigUnsigned& product);
+void MultiplyListAsTree(const std::vector<uint64_t>& factors, size_t begin, size_t end, BigUnsigned& product);
+
+void PrimeSwingFactorial(const unsigned int n, const std::vector<unsigned int>& primes, unsigned int numThreads, BigUnsigned& result);
+void Swing(const unsigned int n, const std::vector<unsigned int>& primes, BigUnsigned& result);
+void SievePrimes(const unsigned int n, std::vector<unsigned int>& primes);
+
+#endif	//	FACTORIAL_H
\ No newline at end of file
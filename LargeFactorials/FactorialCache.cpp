@@ -0,0 +1,94 @@
+#include <cstdint>	//	for uint64_t
+#include <cstddef>	//	for size_t
+#include <map>		//	for map
+#include <thread>	//	for thread
+#include <algorithm>	//	for max
+#include "BigUnsigned.h"
+#include "Multiply.h"
+#include "Factorial.h"
+#include "FactorialCache.h"
+using namespace std;
+
+FactorialCache::FactorialCache(unsigned int interval, size_t maxLimbs)
+	: _interval(max(interval, 1u)), _maxLimbs(maxLimbs), _limbs(0), _clock(0) {
+}
+
+//	Resuming from c costs a product tree over n - c factors and one multiplication by c!.  Once the gap is wider than c
+//	itself, that's no cheaper than starting over.
+void FactorialCache::Compute(const unsigned int n, FactorialMethod method, unsigned int numThreads, BigUnsigned& result) {
+	if (numThreads == 0) {
+		numThreads = max(thread::hardware_concurrency(), 1u);
+	}
+
+	map<unsigned int, Checkpoint>::iterator below = _checkpoints.upper_bound(n);
+	if (below == _checkpoints.begin()) {
+		Factorial(n, method, numThreads, result);
+		AddCheckpoint(n, result);
+		return;
+	}
+
+	--below;
+	unsigned int start = below->first;
+	if (start == n) {
+		below->second.lastUsed = ++_clock;
+		result = below->second.value;
+		return;
+	}
+	if (n - start > start) {
+		Factorial(n, method, numThreads, result);
+		AddCheckpoint(n, result);
+		return;
+	}
+
+	below->second.lastUsed = ++_clock;
+	BigUnsigned product;
+	if (numThreads > 1) {
+		MultiplyRangeInParallel(static_cast<uint64_t>(start) + 1, n, numThreads, product);
+	}
+	else {
+		MultiplyRangeAsTree(static_cast<uint64_t>(start) + 1, n, product);
+	}
+	MultiplyInParallel(below->second.value, product, numThreads, result);
+	AddCheckpoint(n, result);
+}
+
+//	Keeps value as the checkpoint for n, unless another checkpoint is within the interval or it would never fit.
+void FactorialCache::AddCheckpoint(const unsigned int n, const BigUnsigned& value) {
+	if (value.GetLimbCount() > _maxLimbs) {
+		return;
+	}
+
+	map<unsigned int, Checkpoint>::iterator above = _checkpoints.lower_bound(n);
+	if (above != _checkpoints.end() && above->first - n < _interval) {
+		return;
+	}
+	if (above != _checkpoints.begin()) {
+		map<unsigned int, Checkpoint>::iterator below = above;
+		--below;
+		if (n - below->first < _interval) {
+			return;
+		}
+	}
+
+	while (_limbs + value.GetLimbCount() > _maxLimbs) {
+		EvictLeastRecentlyUsed();
+	}
+
+	Checkpoint& checkpoint = _checkpoints[n];
+	checkpoint.value = value;
+	checkpoint.lastUsed = ++_clock;
+	_limbs += value.GetLimbCount();
+}
+
+//	The cache holds few enough checkpoints that a scan for the oldest is cheap next to any factorial worth caching.
+void FactorialCache::EvictLeastRecentlyUsed() {
+	map<unsigned int, Checkpoint>::iterator oldest = _checkpoints.begin();
+	for (map<unsigned int, Checkpoint>::iterator i = _checkpoints.begin(); i != _checkpoints.end(); ++i) {
+		if (i->second.lastUsed < oldest->second.lastUsed) {
+			oldest = i;
+		}
+	}
+
+	_limbs -= oldest->second.value.GetLimbCount();
+	_checkpoints.erase(oldest);
+}
\ No newline at end of file
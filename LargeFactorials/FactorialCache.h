@@ -0,0 +1,55 @@
+#ifndef FACTORIALCACHE_H
+#define FACTORIALCACHE_H
+#pragma once
+
+#include <cstdint>	//	for uint64_t
+#include <cstddef>	//	for size_t
+#include <map>		//	for map
+#include "BigUnsigned.h"
+#include "Factorial.h"
+
+//	Default spacing between checkpoints, and the default number of limbs the checkpoints may hold between them, which is
+//	1 GiB.
+const unsigned int CHECKPOINT_INTERVAL = 1000;
+const size_t CHECKPOINT_CACHE_LIMBS = static_cast<size_t>(1) << 27;
+
+//-------------------------------------------------------------
+//	FactorialCache class answers many factorial queries, keeping some of the answers as checkpoints that later queries
+//	resume from.
+//		A query for n starts from the largest checkpoint c <= n and multiplies in c+1 through n as a product tree, which for
+//		nearby values is far less work than starting from one.  When no checkpoint is close enough to help, n! is computed
+//		from scratch.
+//		An answer becomes a checkpoint when no other checkpoint is within the interval of it, so queries for many values
+//		close together don't fill the cache with near copies.  When the checkpoints outgrow the limb budget, the ones
+//		least recently resumed from are dropped.
+//		NOTE: queries sorted in increasing order make the best use of the cache, since each one can resume from the last.
+class FactorialCache {
+public:
+	//	Create an empty cache with the given checkpoint spacing and limb budget.
+	FactorialCache(unsigned int interval, size_t maxLimbs);
+
+	//	Computes n factorial, storing the answer in "result".
+	//	method and numThreads are as for Factorial(), and are used when n! is computed from scratch.
+	void Compute(const unsigned int n, FactorialMethod method, unsigned int numThreads, BigUnsigned& result);
+
+	size_t GetCheckpointCount() const { return _checkpoints.size(); };
+	size_t GetLimbCount() const { return _limbs; };
+
+private:
+	struct Checkpoint {
+		BigUnsigned value;
+		uint64_t lastUsed;
+	};
+
+	void AddCheckpoint(const unsigned int n, const BigUnsigned& value);
+	void EvictLeastRecentlyUsed();
+
+	std::map<unsigned int, Checkpoint> _checkpoints;
+	unsigned int _interval;
+	size_t _maxLimbs;
+	size_t _limbs;
+	uint64_t _clock;
+};
+//-------------------------------------------------------------
+
+#endif	//	FACTORIALCACHE_H
\ No newline at end of file
@@ -0,0 +1,243 @@
+#include <cstdint>	//	for uint64_t
+#include <cstddef>	//	for size_t
+#include <cmath>	//	for floorl, log10l, powl
+#include <limits>	//	for numeric_limits
+#include <string>	//	for string, to_string
+#include <vector>	//	for vector
+#include <thread>	//	for thread
+#include <algorithm>	//	for min, max
+#include "BigUnsigned.h"
+#include "Multiply.h"
+#include "NTT.h"
+#include "Factorial.h"
+#include "FactorialQueries.h"
+using namespace std;
+
+//	Bases that make the Miller-Rabin test exact for every 64-bit number.
+static const uint64_t MILLER_RABIN_BASES[] = { 2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37 };
+
+//	log10(e) and log10(2 * pi), to the precision of a long double.
+static const long double LOG10_E = 0.434294481903251827651128918916605082L;
+static const long double LOG10_TWO_PI = 0.798179868358115708358929977598250496L;
+
+//	Every trailing zero is a factor of ten, and n! has far more factors of two than of five.
+uint64_t CountTrailingZeros(uint64_t n) {
+	return CountPrimeInFactorial(n, 5);
+}
+
+//	n! has floor(log10(n!)) + 1 digits.  The estimate of log10(n!) only settles that when no integer lies within its
+//	error; otherwise n! is compared with that power of ten while that's affordable.
+uint64_t CountDigits(uint64_t n) {
+	if (n > FACTORIAL_DIGITS_LIMIT) {
+		return 0;
+	}
+	if (n <= FACTORIAL_EXACT_LIMIT) {
+		BigUnsigned result;
+		Factorial(static_cast<unsigned int>(n), PrimeSwing, 1, result);
+		return result.ToString().size();
+	}
+
+	long double error;
+	long double logarithm = Log10Factorial(n, error);
+	uint64_t low = static_cast<uint64_t>(floorl(logarithm - error));
+	uint64_t high = static_cast<uint64_t>(floorl(logarithm + error));
+	if (low == high || n > FACTORIAL_DIGITS_CHECK_LIMIT) {
+		return static_cast<uint64_t>(floorl(logarithm)) + 1;
+	}
+
+	BigUnsigned result;
+	BigUnsigned power;
+	Factorial(static_cast<unsigned int>(n), PrimeSwing, 0, result);
+	PowerOfTen(high, power);
+	return (CompareLimbs(result.GetLimbs(), power.GetLimbs()) >= 0) ? high + 1 : high;
+}
+
+//	The leading digits are 10^frac(log10(n!)), scaled up.  The fraction carries the absolute error of the whole logarithm,
+//	which limits how many of them can be trusted.
+void LeadingDigits(uint64_t n, unsigned int count, string& digits) {
+	if (n <= FACTORIAL_EXACT_LIMIT) {
+		BigUnsigned result;
+		Factorial(static_cast<unsigned int>(n), PrimeSwing, 1, result);
+		digits = result.ToString().substr(0, count);
+		return;
+	}
+
+	long double error;
+	long double logarithm = Log10Factorial(n, error);
+
+	//	A logarithm off by error gives a value off by a factor of about 1 + error * ln(10), so keep one digit fewer than
+	//	that allows.  A uint64_t holds 19 digits, and the fraction never has more than that.
+	int trusted = static_cast<int>(floorl(-log10l(error * 2.302585092994045684L))) - 1;
+	trusted = min(trusted, static_cast<int>(min(count, DECIMAL_CHUNK_DIGITS - 1)));
+	if (trusted <= 0) {
+		digits.clear();
+		return;
+	}
+
+	long double fraction = logarithm - floorl(logarithm);
+	uint64_t scaled = static_cast<uint64_t>(floorl(powl(10.0L, fraction + (trusted - 1))));
+
+	//	Rounding can carry a fraction just under one all the way to the next power of ten.
+	uint64_t limit = 1;
+	for (int i = 0; i < trusted; ++i) {
+		limit *= 10;
+	}
+	digits = to_string(min(scaled, limit - 1));
+}
+
+//	Every product of a full run of modulus consecutive integers is a multiple of it, so n! is too for n >= modulus.
+//	Below that, a prime modulus past its midpoint is handled from the other end by Wilson's theorem, (p - 1)! = -1 mod p:
+//	n! = -1 / ((n + 1) * ... * (p - 1)), which has fewer factors.
+uint64_t FactorialMod(uint64_t n, uint64_t modulus, unsigned int numThreads) {
+	if (modulus == 1 || n >= modulus) {
+		return 0;
+	}
+	if (numThreads == 0) {
+		numThreads = max(thread::hardware_concurrency(), 1u);
+	}
+
+	if (n > (modulus - 1) / 2 && IsPrime(modulus)) {	//	Intentional integer division.
+		uint64_t rest = MultiplyRangeMod(n + 1, modulus - 1, modulus, numThreads);
+		return modulus - InverseMod(rest, modulus);
+	}
+	return MultiplyRangeMod(2, n, modulus, numThreads);
+}
+
+//	Legendre's formula: floor(n / p) + floor(n / p^2) + ..., one term for each power of prime that divides some factor.
+uint64_t CountPrimeInFactorial(uint64_t n, uint64_t prime) {
+	uint64_t count = 0;
+	while (n > 0) {
+		n /= prime;	//	Intentional integer division.
+		count += n;
+	}
+	return count;
+}
+
+//	Returns log10(n!) for n > FACTORIAL_EXACT_LIMIT, storing a bound on its absolute error in "error".
+//		Stirling's series, ln(n!) = n (ln(n) - 1) + ln(2 pi n) / 2 + 1/(12n) - 1/(360n^3) + 1/(1260n^5) - ..., is accurate
+//		far past a long double's precision by the fourth correction term at these n.  The terms are added smallest first
+//		with Kahan's compensation, so the error is essentially the rounding of the first term, a few units in its last place.
+long double Log10Factorial(uint64_t n, long double& error) {
+	long double x = static_cast<long double>(n);
+	long double inverse = 1.0L / x;
+	long double inverseSquared = inverse * inverse;
+
+	long double terms[] = {
+		-inverse * inverseSquared * inverseSquared * inverseSquared / 1680.0L * LOG10_E,
+		inverse * inverseSquared * inverseSquared / 1260.0L * LOG10_E,
+		-inverse * inverseSquared / 360.0L * LOG10_E,
+		inverse / 12.0L * LOG10_E,
+		(LOG10_TWO_PI + log10l(x)) / 2.0L,
+		x * (log10l(x) - LOG10_E)
+	};
+
+	long double sum = 0;
+	long double compensation = 0;
+	for (long double term : terms) {
+		long double adjusted = term - compensation;
+		long double next = sum + adjusted;
+		compensation = (next - sum) - adjusted;
+		sum = next;
+	}
+
+	error = 8 * numeric_limits<long double>::epsilon() * sum;
+	return sum;
+}
+
+//	Returns low * (low + 1) * ... * high mod modulus, which is one if the range is empty.  Every factor must be below the
+//	modulus.
+//		The first FACTORIAL_MOD_PROBE factors are multiplied on one thread, which settles most composite moduli early.  The
+//		rest are split into one segment per thread, and the segments' products multiplied together.
+uint64_t MultiplyRangeMod(uint64_t low, uint64_t high, uint64_t modulus, unsigned int numThreads) {
+	uint64_t product = 1 % modulus;
+	if (high < low) {
+		return product;
+	}
+
+	uint64_t probeHigh = (high - low < FACTORIAL_MOD_PROBE) ? high : low + FACTORIAL_MOD_PROBE - 1;
+	RunRangeModWorker(low, probeHigh, modulus, &product);
+	if (product == 0 || probeHigh == high) {
+		return product;
+	}
+
+	uint64_t count = high - probeHigh;
+	uint64_t segments = min<uint64_t>(max(numThreads, 1u), count / FACTORIAL_MOD_PROBE + 1);	//	Intentional integer division.
+	vector<uint64_t> products(static_cast<size_t>(segments), 1);
+	vector<thread> workers;
+	uint64_t begin = probeHigh + 1;
+	for (uint64_t i = 0; i < segments; ++i) {
+		uint64_t end = begin + count / segments + ((i < count % segments) ? 1 : 0);	//	Intentional integer division.
+		if (i + 1 == segments) {
+			RunRangeModWorker(begin, end - 1, modulus, &products[i]);
+		}
+		else {
+			workers.push_back(thread(RunRangeModWorker, begin, end - 1, modulus, &products[i]));
+		}
+		begin = end;
+	}
+	for (thread& worker : workers) {
+		worker.join();
+	}
+
+	for (uint64_t segmentProduct : products) {
+		product = MultiplyMod(product, segmentProduct, modulus);
+	}
+	return product;
+}
+
+//	Multiplies low through high into "product" mod modulus, stopping early once it's zero.
+void RunRangeModWorker(uint64_t low, uint64_t high, uint64_t modulus, uint64_t* product) {
+	uint64_t result = 1 % modulus;
+	for (uint64_t i = low; i <= high && result != 0; ++i) {
+		result = MultiplyMod(result, i, modulus);
+	}
+	*product = result;
+}
+
+//	Miller-Rabin with a fixed set of bases, which no 64-bit composite passes.
+bool IsPrime(uint64_t n) {
+	if (n < 2) {
+		return false;
+	}
+	for (uint64_t base : MILLER_RABIN_BASES) {
+		if (n % base == 0) {
+			return n == base;
+		}
+	}
+
+	//	n - 1 = odd * 2^twos.
+	uint64_t odd = n - 1;
+	unsigned int twos = 0;
+	while (odd % 2 == 0) {
+		odd /= 2;	//	Intentional integer division.
+		++twos;
+	}
+
+	for (uint64_t base : MILLER_RABIN_BASES) {
+		uint64_t x = PowerMod(base, odd, n);
+		if (x == 1 || x == n - 1) {
+			continue;
+		}
+
+		bool witness = true;
+		for (unsigned int i = 1; i < twos && witness; ++i) {
+			x = MultiplyMod(x, x, n);
+			witness = (x != n - 1);
+		}
+		if (witness) {
+			return false;
+		}
+	}
+	return true;
+}
+
+//	Sets power = 10^exponent, by squaring and multiplying along the exponent's bits from the top.
+void PowerOfTen(uint64_t exponent, BigUnsigned& power) {
+	power = BigUnsigned(1);
+	for (int bit = 63; bit >= 0; --bit) {
+		Multiply(power, power, power);
+		if ((exponent >> bit) & 1) {
+			power.MultiplyBy(10);
+		}
+	}
+}
\ No newline at end of file
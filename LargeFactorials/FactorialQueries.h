@@ -0,0 +1,51 @@
+#ifndef FACTORIALQUERIES_H
+#define FACTORIALQUERIES_H
+#pragma once
+
+#include <cstdint>	//	for uint64_t
+#include <string>	//	for string
+#include "BigUnsigned.h"
+
+//	Up to this n, digit counts and leading digits come from n! itself, which takes milliseconds.  Above it, they come
+//	from Stirling's series for log10(n!), which is accurate to many places there and costs the same for any n.
+const uint64_t FACTORIAL_EXACT_LIMIT = 10000;
+
+//	When log10(n!) lies too close to an integer to be sure of the digit count, n! is compared with the power of ten
+//	exactly, up to this n.  Above it, the nearer count is returned.
+const uint64_t FACTORIAL_DIGITS_CHECK_LIMIT = 1000000;
+
+//	Digit counts are only given up to this n.  log10(n!) is about 1.5e16 here, and a long double's 64-bit significand
+//	still places it to within a few thousandths; well before log10(n!) reaches 2^64, it can no longer tell neighbouring
+//	integers apart.
+const uint64_t FACTORIAL_DIGITS_LIMIT = 1000000000000000;
+
+//	n! mod m multiplies this many factors on one thread before splitting the rest among the threads.  Most composite
+//	moduli divide a product of this many factors, and the answer is zero as soon as the running product is.
+const uint64_t FACTORIAL_MOD_PROBE = 1 << 16;
+
+//	Interface functions
+//		Each answers a question about n! without computing all of it, so n may run far past where n! fits in memory.
+//		Returns the number of zeros n! ends with in decimal, which is the number of factors of five in it.
+uint64_t CountTrailingZeros(uint64_t n);
+//		Returns the number of decimal digits in n!, or 0 for n above FACTORIAL_DIGITS_LIMIT.
+//		NOTE: above FACTORIAL_DIGITS_CHECK_LIMIT, when log10(n!) lies too close to an integer to be sure of it, this is the
+//		nearer estimate, and can be one off.
+uint64_t CountDigits(uint64_t n);
+//		Writes the first count digits of n! into digits, or fewer where the precision of Stirling's series runs out.
+//		NOTE: above FACTORIAL_EXACT_LIMIT the last digit written can be one off when the digits after it are all nines
+//		or all zeros to within that precision.
+void LeadingDigits(uint64_t n, unsigned int count, std::string& digits);
+//		Returns n! mod modulus, which must not be zero.
+//		numThreads is the number of threads to use, or 0 to use one per hardware thread.
+uint64_t FactorialMod(uint64_t n, uint64_t modulus, unsigned int numThreads);
+
+//	Helper functions
+//		Returns the exponent of prime in n!, by Legendre's formula.
+uint64_t CountPrimeInFactorial(uint64_t n, uint64_t prime);
+long double Log10Factorial(uint64_t n, long double& error);
+uint64_t MultiplyRangeMod(uint64_t low, uint64_t high, uint64_t modulus, unsigned int numThreads);
+void RunRangeModWorker(uint64_t low, uint64_t high, uint64_t modulus, uint64_t* product);
+bool IsPrime(uint64_t n);
+void PowerOfTen(uint64_t exponent, BigUnsigned& power);
+
+#endif	//	FACTORIALQUERIES_H
\ No newline at end of file
@@ -0,0 +1,303 @@
+#include <cstdint>		//	for uint64_t
+#include <algorithm>	//	for min
+#include <utility>		//	for move
+#include "BigUnsigned.h"
+#include "Multiply.h"
+#include "NTT.h"
+using namespace std;
+
+void Multiply(const BigUnsigned& a, const BigUnsigned& b, BigUnsigned& product) {
+	//	Build the product separately, since product may be one of the operands.
+	LimbVector limbs;
+	MultiplyLimbVectors(a.GetLimbs(), b.GetLimbs(), limbs);
+	product = BigUnsigned(move(limbs));
+}
+
+void MultiplyInParallel(const BigUnsigned& a, const BigUnsigned& b, unsigned int numThreads, BigUnsigned& product) {
+	LimbVector limbs;
+	if (numThreads > 1 && min(a.GetLimbCount(), b.GetLimbCount()) >= NTT_THRESHOLD) {
+		MultiplyNTT(a.GetLimbs(), b.GetLimbs(), numThreads, limbs);
+	}
+	else {
+		MultiplyLimbVectors(a.GetLimbs(), b.GetLimbs(), limbs);
+	}
+	product = BigUnsigned(move(limbs));
+}
+
+//	Chooses the multiplication by the size of the smaller operand.  Below the NTT threshold, operands of very different sizes
+//	are first cut into pieces the size of the smaller one, since Karatsuba and Toom-3 only pay off when both sides are split
+//	the same way.
+void MultiplyLimbVectors(const LimbVector& a, const LimbVector& b, LimbVector& product) {
+	const LimbVector& larger = (a.size() >= b.size()) ? a : b;
+	const LimbVector& smaller = (a.size() >= b.size()) ? b : a;
+
+	if (smaller.empty()) {
+		product.clear();
+	}
+	else if (smaller.size() < KARATSUBA_THRESHOLD) {
+		MultiplySchoolbook(larger, smaller, product);
+	}
+	else if (smaller.size() >= NTT_THRESHOLD) {
+		MultiplyNTT(larger, smaller, 1, product);
+	}
+	else if (larger.size() >= 2 * smaller.size()) {
+		MultiplyUnbalanced(larger, smaller, product);
+	}
+	else if (smaller.size() < TOOM3_THRESHOLD) {
+		MultiplyKaratsuba(larger, smaller, product);
+	}
+	else {
+		MultiplyToom3(larger, smaller, product);
+	}
+}
+
+//	Multiply larger by each limb of smaller, adding each row into the product one limb further along.
+void MultiplySchoolbook(const LimbVector& larger, const LimbVector& smaller, LimbVector& product) {
+	product.assign(larger.size() + smaller.size(), 0);
+
+	for (size_t j = 0; j < smaller.size(); ++j) {
+		uint64_t carry = 0;
+		for (size_t i = 0; i < larger.size(); ++i) {
+			uint64_t low;
+			uint64_t high;
+			MultiplyLimbs(larger[i], smaller[j], low, high);
+
+			//	Can't overflow: (2^64 - 1)^2 plus two more limbs is exactly 2^128 - 1.
+			low += product[i + j];
+			high += (low < product[i + j]) ? 1 : 0;
+			low += carry;
+			high += (low < carry) ? 1 : 0;
+
+			product[i + j] = low;
+			carry = high;
+		}
+		product[j + larger.size()] = carry;
+	}
+
+	TrimLimbs(product);
+}
+
+//	Multiply smaller by each smaller-sized piece of larger, adding each partial product in at its piece's offset.
+void MultiplyUnbalanced(const LimbVector& larger, const LimbVector& smaller, LimbVector& product) {
+	product.assign(larger.size() + smaller.size(), 0);
+
+	LimbVector piece;
+	LimbVector partial;
+	for (size_t offset = 0; offset < larger.size(); offset += smaller.size()) {
+		SplitLimbs(larger, offset, smaller.size(), piece);
+		MultiplyLimbVectors(piece, smaller, partial);
+		AddLimbsAt(product, partial, offset);
+	}
+
+	TrimLimbs(product);
+}
+
+//	With B = 2^(64 * half), a = a1*B + a0 and b = b1*B + b0, so
+//		a * b = a1*b1*B^2 + ((a0 + a1)(b0 + b1) - a0*b0 - a1*b1)*B + a0*b0
+//	which takes three half-size products instead of four.
+void MultiplyKaratsuba(const LimbVector& larger, const LimbVector& smaller, LimbVector& product) {
+	size_t half = (larger.size() + 1) / 2;	//	Intentional integer division.
+
+	LimbVector a0, a1, b0, b1;
+	SplitLimbs(larger, 0, half, a0);
+	SplitLimbs(larger, half, half, a1);
+	SplitLimbs(smaller, 0, half, b0);
+	SplitLimbs(smaller, half, half, b1);
+
+	LimbVector low, high, middle;
+	MultiplyLimbVectors(a0, b0, low);
+	MultiplyLimbVectors(a1, b1, high);
+
+	AddLimbsAt(a0, a1, 0);
+	AddLimbsAt(b0, b1, 0);
+	MultiplyLimbVectors(a0, b0, middle);
+	SubtractLimbs(middle, low);
+	SubtractLimbs(middle, high);
+
+	product = move(low);
+	product.reserve(larger.size() + smaller.size());
+	AddLimbsAt(product, middle, half);
+	AddLimbsAt(product, high, 2 * half);
+}
+
+//	Splits each operand into three parts, as a polynomial in B = 2^(64 * third), evaluates both at 0, 1, -1, -2 and infinity,
+//	multiplies the values pointwise, and interpolates the product's five coefficients back out.  That's five third-size
+//	products instead of nine.
+//		Interpolation follows Bodrato's sequence, whose only divisions are exact divisions by 2 and 3.
+void MultiplyToom3(const LimbVector& larger, const LimbVector& smaller, LimbVector& product) {
+	size_t third = (larger.size() + 2) / 3;	//	Intentional integer division.
+
+	SignedLimbs pointsA[5];
+	SignedLimbs pointsB[5];
+	EvaluateToom3(larger, third, pointsA);
+	EvaluateToom3(smaller, third, pointsB);
+
+	SignedLimbs r[5];
+	for (unsigned int i = 0; i < 5; ++i) {
+		MultiplyLimbVectors(pointsA[i].magnitude, pointsB[i].magnitude, r[i].magnitude);
+		r[i].negative = !r[i].magnitude.empty() && (pointsA[i].negative != pointsB[i].negative);
+	}
+
+	//	r holds the product at 0, 1, -1, -2, infinity; turn it into the coefficients c0..c4 of B^0..B^4.
+	SignedLimbs& c0 = r[0];
+	SignedLimbs& c4 = r[4];
+	SignedLimbs c1 = r[1];
+	SignedLimbs c2 = r[2];
+	SignedLimbs c3 = r[3];
+
+	AddSigned(c3, r[1].magnitude, !r[1].negative);		//	c3 = (r(-2) - r(1)) / 3
+	DivideExactly(c3, 3);
+	AddSigned(c1, r[2].magnitude, !r[2].negative);		//	c1 = (r(1) - r(-1)) / 2
+	DivideExactly(c1, 2);
+	AddSigned(c2, c0.magnitude, !c0.negative);			//	c2 = r(-1) - r(0)
+
+	SignedLimbs difference = c2;						//	c3 = (c2 - c3) / 2 + 2 * r(inf)
+	AddSigned(difference, c3.magnitude, !c3.negative);
+	DivideExactly(difference, 2);
+	AddSigned(difference, c4.magnitude, c4.negative);
+	AddSigned(difference, c4.magnitude, c4.negative);
+	c3 = move(difference);
+
+	AddSigned(c2, c1.magnitude, c1.negative);			//	c2 = c2 + c1 - r(inf)
+	AddSigned(c2, c4.magnitude, !c4.negative);
+	AddSigned(c1, c3.magnitude, !c3.negative);			//	c1 = c1 - c3
+
+	//	The coefficients of a product of non-negative polynomials are never negative.
+	product = move(c0.magnitude);
+	product.reserve(larger.size() + smaller.size());
+	AddLimbsAt(product, c1.magnitude, third);
+	AddLimbsAt(product, c2.magnitude, 2 * third);
+	AddLimbsAt(product, c3.magnitude, 3 * third);
+	AddLimbsAt(product, c4.magnitude, 4 * third);
+}
+
+//	Evaluates value = v2*B^2 + v1*B + v0 at 0, 1, -1, -2 and infinity.
+void EvaluateToom3(const LimbVector& value, size_t partSize, SignedLimbs points[5]) {
+	LimbVector v0, v1, v2;
+	SplitLimbs(value, 0, partSize, v0);
+	SplitLimbs(value, partSize, partSize, v1);
+	SplitLimbs(value, 2 * partSize, partSize, v2);
+
+	SignedLimbs sum = { v0, false };					//	v0 + v2
+	AddSigned(sum, v2, false);
+
+	points[0] = { v0, false };							//	p(0) = v0
+	points[1] = sum;									//	p(1) = v0 + v1 + v2
+	AddSigned(points[1], v1, false);
+	points[2] = move(sum);								//	p(-1) = v0 - v1 + v2
+	AddSigned(points[2], v1, true);
+
+	points[3] = points[2];								//	p(-2) = 2 * (p(-1) + v2) - v0
+	AddSigned(points[3], v2, false);
+	LimbVector doubled = points[3].magnitude;
+	AddLimbsAt(points[3].magnitude, doubled, 0);
+	AddSigned(points[3], v0, true);
+
+	points[4] = { move(v2), false };					//	p(inf) = v2
+}
+
+//	Adds a signed value to target.
+void AddSigned(SignedLimbs& target, const LimbVector& magnitude, bool negative) {
+	if (target.negative == negative) {
+		AddLimbsAt(target.magnitude, magnitude, 0);
+	}
+	else if (CompareLimbs(target.magnitude, magnitude) >= 0) {
+		SubtractLimbs(target.magnitude, magnitude);
+	}
+	else {
+		LimbVector difference = magnitude;
+		SubtractLimbs(difference, target.magnitude);
+		target.magnitude = move(difference);
+		target.negative = negative;
+	}
+
+	if (target.magnitude.empty()) {
+		target.negative = false;
+	}
+}
+
+//	Divides by a single-limb divisor that's known to leave no remainder, from the most significant limb down.
+void DivideExactly(SignedLimbs& value, uint64_t divisor) {
+	uint64_t remainder = 0;
+	for (size_t i = value.magnitude.size(); i-- > 0; ) {
+		value.magnitude[i] = DivideLimbs(remainder, value.magnitude[i], divisor, remainder);
+	}
+	TrimLimbs(value.magnitude);
+}
+
+//	Copies up to count limbs of value, starting at limb start, into part.  Parts past the end of value are zero.
+void SplitLimbs(const LimbVector& value, size_t start, size_t count, LimbVector& part) {
+	if (start >= value.size()) {
+		part.clear();
+		return;
+	}
+
+	part.assign(value.begin() + start, value.begin() + min(start + count, value.size()));
+	TrimLimbs(part);
+}
+
+//	Adds value, shifted up by offset limbs, into target, growing target as needed.
+void AddLimbsAt(LimbVector& target, const LimbVector& value, size_t offset) {
+	if (value.empty()) {
+		return;
+	}
+	if (target.size() < offset + value.size()) {
+		target.resize(offset + value.size(), 0);
+	}
+
+	uint64_t carry = 0;
+	for (size_t i = 0; i < value.size(); ++i) {
+		uint64_t sum = target[offset + i] + value[i];
+		uint64_t nextCarry = (sum < value[i]) ? 1 : 0;
+		sum += carry;
+		nextCarry += (sum < carry) ? 1 : 0;
+
+		target[offset + i] = sum;
+		carry = nextCarry;
+	}
+
+	for (size_t i = offset + value.size(); carry != 0; ++i) {
+		if (i == target.size()) {
+			target.push_back(0);
+		}
+		carry = (++target[i] == 0) ? 1 : 0;
+	}
+}
+
+//	Subtracts value from target, which must be at least as large.
+void SubtractLimbs(LimbVector& target, const LimbVector& value) {
+	uint64_t borrow = 0;
+	for (size_t i = 0; i < target.size() && (i < value.size() || borrow != 0); ++i) {
+		uint64_t subtrahend = (i < value.size()) ? value[i] : 0;
+		uint64_t difference = target[i] - subtrahend;
+		uint64_t nextBorrow = (target[i] < subtrahend) ? 1 : 0;
+		nextBorrow += (difference < borrow) ? 1 : 0;
+
+		target[i] = difference - borrow;
+		borrow = nextBorrow;
+	}
+
+	TrimLimbs(target);
+}
+
+//	Returns a negative number, zero, or a positive number as a is less than, equal to, or greater than b.
+int CompareLimbs(const LimbVector& a, const LimbVector& b) {
+	if (a.size() != b.size()) {
+		return (a.size() < b.size()) ? -1 : 1;
+	}
+
+	for (size_t i = a.size(); i-- > 0; ) {
+		if (a[i] != b[i]) {
+			return (a[i] < b[i]) ? -1 : 1;
+		}
+	}
+
+	return 0;
+}
+
+//	Drops leading zero limbs.
+void TrimLimbs(LimbVector& value) {
+	while (!value.empty() && value.back() == 0) {
+		value.pop_back();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+#ifndef MULTIPLY_H
+#define MULTIPLY_H
+#pragma once
+
+#include <cstddef>	//	for size_t
+#include <vector>	//	for vector
+#include "BigUnsigned.h"
+
+//	Operand sizes, in limbs of the smaller operand, at which multiplication switches from schoolbook to Karatsuba, from
+//	Karatsuba to Toom-3, and from Toom-3 to number-theoretic transforms.  Tuned by timing balanced products on x86-64; below
+//	them the extra additions cost more than they save.
+const size_t KARATSUBA_THRESHOLD = 32;
+const size_t TOOM3_THRESHOLD = 160;
+const size_t NTT_THRESHOLD = 2048;
+
+//	Limbs of a value, least significant first, with no leading zero limbs, as held by BigUnsigned.
+typedef std::vector<BigUnsigned::Limb> LimbVector;
+
+//	A limb vector with a sign, for the intermediate values of Toom-3, which can go negative.
+struct SignedLimbs {
+	LimbVector magnitude;
+	bool negative;
+};
+
+//	Interface functions
+//		Computes product = a * b.  product may be the same object as a or b.
+void Multiply(const BigUnsigned& a, const BigUnsigned& b, BigUnsigned& product);
+//		Same, but splits a multiplication large enough for number-theoretic transforms among numThreads threads.
+void MultiplyInParallel(const BigUnsigned& a, const BigUnsigned& b, unsigned int numThreads, BigUnsigned& product);
+
+//	Helper functions
+//		Each multiplication requires larger.size() >= smaller.size(), and product must not be either operand.
+void MultiplyLimbVectors(const LimbVector& a, const LimbVector& b, LimbVector& product);
+void MultiplySchoolbook(const LimbVector& larger, const LimbVector& smaller, LimbVector& product);
+void MultiplyUnbalanced(const LimbVector& larger, const LimbVector& smaller, LimbVector& product);
+void MultiplyKaratsuba(const LimbVector& larger, const LimbVector& smaller, LimbVector& product);
+void MultiplyToom3(const LimbVector& larger, const LimbVector& smaller, LimbVector& product);
+
+void EvaluateToom3(const LimbVector& value, size_t partSize, SignedLimbs points[5]);
+void AddSigned(SignedLimbs& target, const LimbVector& magnitude, bool negative);
+void DivideExactly(SignedLimbs& value, uint64_t divisor);
+
+void SplitLimbs(const LimbVector& value, size_t start, size_t count, LimbVector& part);
+void AddLimbsAt(LimbVector& target, const LimbVector& value, size_t offset);
+void SubtractLimbs(LimbVector& target, const LimbVector& value);
+int CompareLimbs(const LimbVector& a, const LimbVector& b);
+void TrimLimbs(LimbVector& value);
+
+#endif	//	MULTIPLY_H
\ No newline at end of file
@@ -0,0 +1,375 @@
+#include <cstdint>	//	for uint64_t
+#include <vector>	//	for vector
+#include <thread>	//	for thread
+#include <algorithm>	//	for max
+#include <functional>	//	for cref, ref
+#include "BigUnsigned.h"
+#include "Multiply.h"
+#include "NTT.h"
+using namespace std;
+
+//	Modular arithmetic on values already reduced modulo the prime.
+//		Every prime is below 2^62, so a value that has gone negative has its top bit set, and the prime can be added back
+//		under a mask instead of a branch.  Transformed values are effectively random, so such a branch would mispredict
+//		about half the time.
+static inline uint64_t AddBackPrime(uint64_t value, const NTTModulus& modulus) {
+	return value + (modulus.prime & (0 - (value >> 63)));
+}
+
+static inline uint64_t AddMod(uint64_t a, uint64_t b, const NTTModulus& modulus) {
+	return AddBackPrime(a + b - modulus.prime, modulus);
+}
+
+static inline uint64_t SubtractMod(uint64_t a, uint64_t b, const NTTModulus& modulus) {
+	return AddBackPrime(a - b, modulus);
+}
+
+//	Returns a * b / R mod prime, without a division.
+//		Multiplying a plain value by one in Montgomery form (b * R mod prime) gives a plain value back, so the data being
+//		transformed stays in plain form and only the twiddle factors are converted.
+static inline uint64_t MontgomeryMultiply(uint64_t a, uint64_t b, const NTTModulus& modulus) {
+	uint64_t low;
+	uint64_t high;
+	MultiplyLimbs(a, b, low, high);
+
+	//	Adding reducer * prime clears the low limb, so the result is the high limb plus the carry out of the low one.
+	uint64_t reducerLow;
+	uint64_t reducerHigh;
+	MultiplyLimbs(low * modulus.negativeInverse, modulus.prime, reducerLow, reducerHigh);
+
+	return AddBackPrime(high + reducerHigh + ((low != 0) ? 1 : 0) - modulus.prime, modulus);
+}
+
+void MultiplyNTT(const LimbVector& a, const LimbVector& b, unsigned int numThreads, LimbVector& product) {
+	size_t coefficients = a.size() + b.size() - 1;
+	size_t length = 1;
+	while (length < coefficients) {
+		length *= 2;
+	}
+
+	vector<uint64_t> residues[NTT_PRIME_COUNT];
+	if (numThreads <= 1 || length < NTT_PARALLEL_LENGTH) {
+		for (unsigned int i = 0; i < NTT_PRIME_COUNT; ++i) {
+			ConvolveModPrime(a, b, length, i, 1, residues[i]);
+		}
+	}
+	else {
+		unsigned int threadsPerPrime = max(numThreads / NTT_PRIME_COUNT, 1u);	//	Intentional integer division.
+
+		vector<thread> workers;
+		for (unsigned int i = 0; i < NTT_PRIME_COUNT; ++i) {
+			workers.push_back(thread(ConvolveModPrime, cref(a), cref(b), length, i, threadsPerPrime, ref(residues[i])));
+		}
+		for (unsigned int i = 0; i < NTT_PRIME_COUNT; ++i) {
+			workers[i].join();
+		}
+	}
+
+	RecombineResidues(residues, coefficients, numThreads, product);
+}
+
+//	Computes the cyclic convolution of the limbs of a and b, modulo one prime, into residues.
+//		length must be a power of two at least a.size() + b.size() - 1, so the convolution doesn't wrap around.
+void ConvolveModPrime(const LimbVector& a, const LimbVector& b, size_t length, unsigned int primeIndex, unsigned int numThreads, vector<uint64_t>& residues) {
+	NTTModulus modulus;
+	InitModulus(NTT_PRIMES[primeIndex], modulus);
+	uint64_t prime = modulus.prime;
+
+	residues.assign(length, 0);
+	for (size_t i = 0; i < a.size(); ++i) {
+		residues[i] = a[i] % prime;
+	}
+	vector<uint64_t> other(length, 0);
+	for (size_t i = 0; i < b.size(); ++i) {
+		other[i] = b[i] % prime;
+	}
+
+	uint64_t root = PowerMod(NTT_PRIMITIVE_ROOTS[primeIndex], (prime - 1) / length, prime);	//	Intentional integer division.
+	vector<uint64_t> twiddles;
+	ComputeTwiddles(root, length, modulus, twiddles);
+	TransformForward(residues, twiddles, modulus, numThreads);
+	TransformForward(other, twiddles, modulus, numThreads);
+
+	for (size_t i = 0; i < length; ++i) {
+		residues[i] = MontgomeryMultiply(residues[i], other[i], modulus);
+	}
+
+	ComputeTwiddles(InverseMod(root, prime), length, modulus, twiddles);
+	TransformInverse(residues, twiddles, modulus, numThreads);
+
+	//	The pointwise products divided every value by R, and the inverse transform multiplied it by length.
+	//	Undo both at once with length^-1 * R, which is length^-1 * R^2 in Montgomery form.
+	uint64_t rSquared = MultiplyMod(modulus.rModPrime, modulus.rModPrime, prime);
+	uint64_t scale = MultiplyMod(InverseMod(length % prime, prime), rSquared, prime);
+	for (size_t i = 0; i < length; ++i) {
+		residues[i] = MontgomeryMultiply(residues[i], scale, modulus);
+	}
+}
+
+//	Fills twiddles, in Montgomery form, so that twiddles[half + j] = w^j for each power of two half < length, where w is
+//	a primitive (2 * half)th root of unity derived from root, a primitive lengthth one.  That's every factor a butterfly
+//	at that level uses, laid out contiguously.
+void ComputeTwiddles(uint64_t root, size_t length, const NTTModulus& modulus, vector<uint64_t>& twiddles) {
+	twiddles.assign(length, 0);
+
+	uint64_t step = root;
+	for (size_t half = length / 2; half >= 1; half /= 2) {	//	Intentional integer division.
+		uint64_t stepMontgomery = MultiplyMod(step, modulus.rModPrime, modulus.prime);
+
+		twiddles[half] = modulus.rModPrime;
+		for (size_t j = 1; j < half; ++j) {
+			twiddles[half + j] = MontgomeryMultiply(twiddles[half + j - 1], stepMontgomery, modulus);
+		}
+
+		step = MultiplyMod(step, step, modulus.prime);
+	}
+}
+
+//	Decimation in frequency: takes values in natural order and leaves the transform in bit-reversed order, which is fine,
+//	since the pointwise product doesn't care about order and TransformInverse() expects it.
+void TransformForward(vector<uint64_t>& values, const vector<uint64_t>& twiddles, const NTTModulus& modulus, unsigned int numThreads) {
+	size_t length = values.size();
+	unsigned int blocks = GetTransformBlocks(length, numThreads);
+	if (blocks == 1) {
+		ForwardButterflies(values.data(), length, length / 2, 1, 0, 1, &twiddles, &modulus);
+		return;
+	}
+
+	//	The top levels mix values from across the whole array, so each thread takes a slice of every butterfly group,
+	//	one level at a time.
+	vector<thread> workers;
+	for (size_t half = length / 2; half >= length / blocks; half /= 2) {	//	Intentional integer division.
+		for (unsigned int slice = 0; slice < blocks; ++slice) {
+			workers.push_back(thread(ForwardButterflies, values.data(), length, half, half, slice, blocks, &twiddles, &modulus));
+		}
+		for (thread& worker : workers) {
+			worker.join();
+		}
+		workers.clear();
+	}
+
+	//	Below them, each block of length / blocks values is a transform of its own.
+	size_t blockLength = length / blocks;
+	for (unsigned int block = 0; block < blocks; ++block) {
+		workers.push_back(thread(ForwardButterflies, values.data() + block * blockLength, blockLength, blockLength / 2, 1, 0, 1, &twiddles, &modulus));
+	}
+	for (thread& worker : workers) {
+		worker.join();
+	}
+}
+
+//	Decimation in time: takes values in bit-reversed order and leaves them in natural order, still multiplied by length.
+//	The levels run in the opposite order to TransformForward(), so the independent blocks come first.
+void TransformInverse(vector<uint64_t>& values, const vector<uint64_t>& twiddles, const NTTModulus& modulus, unsigned int numThreads) {
+	size_t length = values.size();
+	unsigned int blocks = GetTransformBlocks(length, numThreads);
+	if (blocks == 1) {
+		InverseButterflies(values.data(), length, 1, length / 2, 0, 1, &twiddles, &modulus);
+		return;
+	}
+
+	vector<thread> workers;
+	size_t blockLength = length / blocks;
+	for (unsigned int block = 0; block < blocks; ++block) {
+		workers.push_back(thread(InverseButterflies, values.data() + block * blockLength, blockLength, 1, blockLength / 2, 0, 1, &twiddles, &modulus));
+	}
+	for (thread& worker : workers) {
+		worker.join();
+	}
+	workers.clear();
+
+	for (size_t half = blockLength; half < length; half *= 2) {
+		for (unsigned int slice = 0; slice < blocks; ++slice) {
+			workers.push_back(thread(InverseButterflies, values.data(), length, half, half, slice, blocks, &twiddles, &modulus));
+		}
+		for (thread& worker : workers) {
+			worker.join();
+		}
+		workers.clear();
+	}
+}
+
+//	Runs the forward butterflies of each level from topHalf down to bottomHalf over length values.
+//	Within each group, only the slice'th of sliceCount equal shares of the butterflies is run.
+void ForwardButterflies(uint64_t* values, size_t length, size_t topHalf, size_t bottomHalf, unsigned int slice, unsigned int sliceCount, const vector<uint64_t>* twiddles, const NTTModulus* modulus) {
+	for (size_t half = topHalf; half >= bottomHalf && half >= 1; half /= 2) {	//	Intentional integer division.
+		size_t first = half * slice / sliceCount;
+		size_t last = half * (slice + 1) / sliceCount;
+		for (size_t start = 0; start < length; start += 2 * half) {
+			for (size_t j = first; j < last; ++j) {
+				uint64_t u = values[start + j];
+				uint64_t v = values[start + j + half];
+				values[start + j] = AddMod(u, v, *modulus);
+				values[start + j + half] = MontgomeryMultiply(SubtractMod(u, v, *modulus), (*twiddles)[half + j], *modulus);
+			}
+		}
+	}
+}
+
+//	Runs the inverse butterflies of each level from bottomHalf up to topHalf over length values, sliced as in ForwardButterflies().
+void InverseButterflies(uint64_t* values, size_t length, size_t bottomHalf, size_t topHalf, unsigned int slice, unsigned int sliceCount, const vector<uint64_t>* twiddles, const NTTModulus* modulus) {
+	for (size_t half = bottomHalf; half <= topHalf && half < length; half *= 2) {
+		size_t first = half * slice / sliceCount;
+		size_t last = half * (slice + 1) / sliceCount;
+		for (size_t start = 0; start < length; start += 2 * half) {
+			for (size_t j = first; j < last; ++j) {
+				uint64_t u = values[start + j];
+				uint64_t v = MontgomeryMultiply(values[start + j + half], (*twiddles)[half + j], *modulus);
+				values[start + j] = AddMod(u, v, *modulus);
+				values[start + j + half] = SubtractMod(u, v, *modulus);
+			}
+		}
+	}
+}
+
+//	Returns how many blocks, and threads, to split a transform into: the largest power of two no more than numThreads,
+//	or one if the transform is too short to be worth splitting.
+unsigned int GetTransformBlocks(size_t length, unsigned int numThreads) {
+	if (length < NTT_PARALLEL_LENGTH) {
+		return 1;
+	}
+
+	unsigned int blocks = 1;
+	while (blocks * 2 <= numThreads) {
+		blocks *= 2;
+	}
+	return blocks;
+}
+
+//	Rebuilds the product from the residues, splitting the coefficients among the threads.  Each slice is rebuilt on its own,
+//	and the slices are then added together at their offsets.
+void RecombineResidues(const vector<uint64_t> residues[NTT_PRIME_COUNT], size_t coefficients, unsigned int numThreads, LimbVector& product) {
+	unsigned int slices = (numThreads > 1 && coefficients >= NTT_PARALLEL_LENGTH) ? numThreads : 1;
+	vector<LimbVector> partials(slices);
+
+	vector<thread> workers;
+	for (unsigned int slice = 0; slice < slices; ++slice) {
+		size_t begin = coefficients * slice / slices;
+		size_t end = coefficients * (slice + 1) / slices;
+		if (slices == 1) {
+			RecombineRange(residues, begin, end, &partials[slice]);
+		}
+		else {
+			workers.push_back(thread(RecombineRange, residues, begin, end, &partials[slice]));
+		}
+	}
+	for (thread& worker : workers) {
+		worker.join();
+	}
+
+	product.assign(coefficients + 1, 0);
+	for (unsigned int slice = 0; slice < slices; ++slice) {
+		AddLimbsAt(product, partials[slice], coefficients * slice / slices);
+	}
+	TrimLimbs(product);
+}
+
+//	Rebuilds coefficients begin through end - 1 from their three residues with Garner's method,
+//		x = v1 + v2 * p1 + v3 * p1 * p2
+//	where each v is found modulo its own prime, then adds them together, one limb further along each time, into partial.
+void RecombineRange(const vector<uint64_t>* residues, size_t begin, size_t end, LimbVector* partial) {
+	const uint64_t p1 = NTT_PRIMES[0];
+	const uint64_t p2 = NTT_PRIMES[1];
+	const uint64_t p3 = NTT_PRIMES[2];
+	const uint64_t inverseP1ModP2 = InverseMod(p1 % p2, p2);
+	const uint64_t inverseP1ModP3 = InverseMod(p1 % p3, p3);
+	const uint64_t inverseP2ModP3 = InverseMod(p2 % p3, p3);
+
+	uint64_t p1p2Low;
+	uint64_t p1p2High;
+	MultiplyLimbs(p1, p2, p1p2Low, p1p2High);
+
+	partial->assign(end - begin + 3, 0);
+
+	//	The running sum of the coefficients not yet written out, shifted down by one limb per coefficient.
+	//	Each coefficient is below p1 * p2 * p3 < 2^186, so three limbs always hold it.
+	uint64_t carry[3] = { 0, 0, 0 };
+	for (size_t k = begin; k < end; ++k) {
+		uint64_t v1 = residues[0][k];
+		uint64_t v2 = MultiplyMod((residues[1][k] + p2 - v1 % p2) % p2, inverseP1ModP2, p2);
+		uint64_t v3 = MultiplyMod((residues[2][k] + p3 - v1 % p3) % p3, inverseP1ModP3, p3);
+		v3 = MultiplyMod((v3 + p3 - v2 % p3) % p3, inverseP2ModP3, p3);
+
+		//	x = v1 + v2 * p1, which is below p1 * p2 and so fits in two limbs...
+		uint64_t x[3];
+		MultiplyLimbs(v2, p1, x[0], x[1]);
+		x[0] += v1;
+		x[1] += (x[0] < v1) ? 1 : 0;
+
+		//	...plus v3 * p1 * p2.
+		uint64_t low, high, upperLow, upperHigh;
+		MultiplyLimbs(v3, p1p2Low, low, high);
+		MultiplyLimbs(v3, p1p2High, upperLow, upperHigh);
+		high += upperLow;
+		x[2] = upperHigh + ((high < upperLow) ? 1 : 0);
+
+		x[0] += low;
+		uint64_t overflow = (x[0] < low) ? 1 : 0;
+		x[1] += overflow;
+		overflow = (x[1] < overflow) ? 1 : 0;
+		x[1] += high;
+		overflow += (x[1] < high) ? 1 : 0;
+		x[2] += overflow;
+
+		//	Add the coefficient to the carry, write out the lowest limb, and shift the rest down.
+		overflow = 0;
+		for (unsigned int i = 0; i < 3; ++i) {
+			uint64_t sum = carry[i] + overflow;
+			overflow = (sum < overflow) ? 1 : 0;
+			sum += x[i];
+			overflow += (sum < x[i]) ? 1 : 0;
+			carry[i] = sum;
+		}
+
+		(*partial)[k - begin] = carry[0];
+		carry[0] = carry[1];
+		carry[1] = carry[2];
+		carry[2] = 0;
+	}
+
+	//	Write out whatever carry is left over.
+	for (unsigned int i = 0; i < 3; ++i) {
+		(*partial)[end - begin + i] = carry[i];
+	}
+	TrimLimbs(*partial);
+}
+
+void InitModulus(uint64_t prime, NTTModulus& modulus) {
+	modulus.prime = prime;
+
+	//	Newton's iteration doubles the number of correct low bits each time, and an odd prime is its own inverse mod 8.
+	uint64_t inverse = prime;
+	for (unsigned int i = 0; i < 5; ++i) {
+		inverse *= 2 - prime * inverse;
+	}
+	modulus.negativeInverse = 0 - inverse;
+
+	modulus.rModPrime = (0 - prime) % prime;
+}
+
+//	Returns a * b mod prime, for a and b already reduced modulo the prime.
+uint64_t MultiplyMod(uint64_t a, uint64_t b, uint64_t prime) {
+	uint64_t low;
+	uint64_t high;
+	MultiplyLimbs(a, b, low, high);
+
+	uint64_t remainder;
+	DivideLimbs(high, low, prime, remainder);
+	return remainder;
+}
+
+uint64_t PowerMod(uint64_t base, uint64_t exponent, uint64_t prime) {
+	uint64_t result = 1;
+	for (; exponent != 0; exponent >>= 1) {
+		if (exponent & 1) {
+			result = MultiplyMod(result, base, prime);
+		}
+		base = MultiplyMod(base, base, prime);
+	}
+	return result;
+}
+
+//	By Fermat's little theorem, value^(prime - 2) is value's inverse.
+uint64_t InverseMod(uint64_t value, uint64_t prime) {
+	return PowerMod(value, prime - 2, prime);
+}
\ No newline at end of file
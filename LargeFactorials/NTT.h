@@ -0,0 +1,50 @@
+#ifndef NTT_H
+#define NTT_H
+#pragma once
+
+#include <cstdint>	//	for uint64_t
+#include <cstddef>	//	for size_t
+#include <vector>	//	for vector
+#include "Multiply.h"
+
+//	Primes of the form c * 2^32 + 1 just under 2^62, each with a primitive root.
+//		Each supports transforms of up to 2^32 points.  Their product is just under 2^186, which bounds every coefficient
+//		of a product of 64-bit limbs, (2^64 - 1)^2 times the smaller operand's limb count, for any operand that fits in memory.
+const unsigned int NTT_PRIME_COUNT = 3;
+const uint64_t NTT_PRIMES[NTT_PRIME_COUNT] = { 0x3fffffee00000001ull, 0x3fffffb400000001ull, 0x3fffffa000000001ull };
+const uint64_t NTT_PRIMITIVE_ROOTS[NTT_PRIME_COUNT] = { 3, 19, 3 };
+const unsigned int NTT_MAX_LOG_LENGTH = 32;
+
+//	Transforms shorter than this run on one thread, since starting threads would cost more than they save.
+const size_t NTT_PARALLEL_LENGTH = 1 << 14;
+
+//	A prime with the constants for Montgomery multiplication modulo it, with R = 2^64.
+struct NTTModulus {
+	uint64_t prime;
+	uint64_t negativeInverse;	//	-prime^-1 mod R.
+	uint64_t rModPrime;			//	R mod prime, which is one in Montgomery form.
+};
+
+//	Interface functions
+//		Computes product = a * b by convolving the limbs modulo each of the NTT primes and recombining the results with the
+//		Chinese Remainder Theorem.  Every step is exact integer arithmetic.  product must not be either operand.
+//		With more than one thread, each prime gets its own thread and a share of the rest to split its transforms among.
+void MultiplyNTT(const LimbVector& a, const LimbVector& b, unsigned int numThreads, LimbVector& product);
+
+//	Helper functions
+void ConvolveModPrime(const LimbVector& a, const LimbVector& b, size_t length, unsigned int primeIndex, unsigned int numThreads, std::vector<uint64_t>& residues);
+void ComputeTwiddles(uint64_t root, size_t length, const NTTModulus& modulus, std::vector<uint64_t>& twiddles);
+void TransformForward(std::vector<uint64_t>& values, const std::vector<uint64_t>& twiddles, const NTTModulus& modulus, unsigned int numThreads);
+void TransformInverse(std::vector<uint64_t>& values, const std::vector<uint64_t>& twiddles, const NTTModulus& modulus, unsigned int numThreads);
+void ForwardButterflies(uint64_t* values, size_t length, size_t topHalf, size_t bottomHalf, unsigned int slice, unsigned int sliceCount, const std::vector<uint64_t>* twiddles, const NTTModulus* modulus);
+void InverseButterflies(uint64_t* values, size_t length, size_t bottomHalf, size_t topHalf, unsigned int slice, unsigned int sliceCount, const std::vector<uint64_t>* twiddles, const NTTModulus* modulus);
+unsigned int GetTransformBlocks(size_t length, unsigned int numThreads);
+void RecombineResidues(const std::vector<uint64_t> residues[NTT_PRIME_COUNT], size_t coefficients, unsigned int numThreads, LimbVector& product);
+void RecombineRange(const std::vector<uint64_t>* residues, size_t begin, size_t end, LimbVector* partial);
+
+void InitModulus(uint64_t prime, NTTModulus& modulus);
+uint64_t MultiplyMod(uint64_t a, uint64_t b, uint64_t prime);
+uint64_t PowerMod(uint64_t base, uint64_t exponent, uint64_t prime);
+uint64_t InverseMod(uint64_t value, uint64_t prime);
+
+#endif	//	NTT_H
\ No newline at end of file
@@ -1,65 +1,259 @@
 /*
-	PROBLEM: Compute N!, allowing for 1 <= N <= 100.
+	PROBLEM: Compute N!, for any N whose factorial fits in memory.
 				Note that for values of N > 20 can't be stored even in a 64-bit variable.
 
-	SOLUTION: Construct the number as a string, performing the multiplication manually.
+	SOLUTION: Construct the number as a BigUnsigned, a vector of 64-bit limbs, performing the multiplication manually.
+				Each limb holds about 19 decimal digits, so the running product takes a fraction of the memory and work
+				of storing one digit per element.
+				By default N! is built by Luschny's prime-swing recursion, N! = ((N/2)!)^2 * swing(N), where swing(N) is
+				assembled from its prime factorization.  The big multiplications switch from schoolbook to Karatsuba to
+				Toom-3, and finally to number-theoretic transforms, as the numbers grow.
+				The decimal text is produced by splitting the result in half by powers of ten, recursively, with the divisions
+				done by multiplying by precomputed reciprocals, and is written out in one piece.
+
+	USAGE:	LargeFactorials [-s | -t] [-j threads] [-b [-k interval]] [-z | -d | -l count | -m modulus] [-c k | -p k | -e | -u]
+				Reads N from standard input and writes N! to standard output.
+				-s multiplies the factors into the running product one at a time.
+				-t multiplies the factors as a product tree, so the big multiplications are between numbers of similar size.
+				-j sets the number of threads, which defaults to one per hardware thread.  The product tree splits the range
+				among them, and both it and the prime swing split their largest multiplications among them.  The decimal
+				conversion splits its halves among them.
+				-b reads any number of N, up to the end of the input, and writes a line "N N!" for each distinct N in
+				increasing order.  Each answer resumes from an earlier one where that's cheaper, through a FactorialCache.
+				-k sets the spacing of the batch mode's checkpoints, which defaults to CHECKPOINT_INTERVAL.
+				-z, -d, -l, and -m write only the number of trailing zeros, the number of digits, the first count digits, or
+				the remainder mod modulus of N!, without computing all of it, so N may go up to 2^64 - 1, except for -d,
+				which goes up to FACTORIAL_DIGITS_LIMIT (10^15).  Past FACTORIAL_DIGITS_CHECK_LIMIT, a digit count whose
+				logarithm lies too close to an integer is the nearer estimate, and can be one off.
+				-c, -p, and -e write the binomial coefficient C(N, k), the falling factorial N! / (N - k)!, or the double
+				factorial N!!, each built from its prime factorization without forming N!.
+				-u reads counts k1, k2, ... up to the end of the input instead of N, and writes the multinomial coefficient
+				(k1 + k2 + ...)! / (k1! k2! ...).  The counts must sum to at most 2^32 - 1.
+				Benchmark/Benchmark.cpp times each method against the others.
 */
 
-#include <vector>
+#include <cstring>
+#include <cstdlib>
+#include <cstdint>
 #include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include "BigUnsigned.h"
+#include "Factorial.h"
+#include "FactorialCache.h"
+#include "Decimal.h"
+#include "FactorialQueries.h"
+#include "Combinatorics.h"
 using namespace std;
 
-//	Computes n factorial, storing the answer in "result".
-void Factorial(const unsigned int n, vector<unsigned int>& result);
+//	What to write about N!, when not all of it.
+enum FactorialQuery {
+	AllDigits,
+	TrailingZeros,
+	DigitCount,
+	Leading,
+	Remainder
+};
+
+//	Which relative of N! to write, built from prime factorizations (see Combinatorics.h).
+enum FactorialVariant {
+	PlainFactorial,
+	BinomialCoefficient,
+	FallingProduct,
+	DoubleProduct,
+	MultinomialCoefficient
+};
+
+void RunBatch(FactorialMethod method, unsigned int numThreads, unsigned int interval);
+void WriteResult(const BigUnsigned& result, unsigned int numThreads, string& text);
+bool RunQuery(FactorialQuery query, unsigned int count, uint64_t modulus, unsigned int numThreads);
+bool RunVariant(FactorialVariant variant, unsigned int k, unsigned int numThreads);
 
-//	Computes product of some integer curN and some potentially large integer num.
-void Multiply(const unsigned int curN, vector<unsigned int>& num);
+int main(int argc, char* argv[]) {
+	//  Input the parameters.
+	FactorialMethod method = PrimeSwing;
+	unsigned int numThreads = 0;
+	bool batch = false;
+	unsigned int interval = CHECKPOINT_INTERVAL;
+	FactorialQuery query = AllDigits;
+	unsigned int count = 0;
+	uint64_t modulus = 0;
+	FactorialVariant variant = PlainFactorial;
+	unsigned int k = 0;
+	for (int arg = 1; arg < argc; ++arg) {
+		if (strcmp(argv[arg], "-s") == 0) {
+			method = SequentialProduct;
+		}
+		else if (strcmp(argv[arg], "-t") == 0) {
+			method = ProductTree;
+		}
+		else if (strcmp(argv[arg], "-j") == 0 && arg + 1 < argc) {
+			numThreads = static_cast<unsigned int>(strtoul(argv[++arg], nullptr, 10));
+		}
+		else if (strcmp(argv[arg], "-b") == 0) {
+			batch = true;
+		}
+		else if (strcmp(argv[arg], "-k") == 0 && arg + 1 < argc) {
+			interval = static_cast<unsigned int>(strtoul(argv[++arg], nullptr, 10));
+		}
+		else if (strcmp(argv[arg], "-z") == 0) {
+			query = TrailingZeros;
+		}
+		else if (strcmp(argv[arg], "-d") == 0) {
+			query = DigitCount;
+		}
+		else if (strcmp(argv[arg], "-l") == 0 && arg + 1 < argc) {
+			query = Leading;
+			count = static_cast<unsigned int>(strtoul(argv[++arg], nullptr, 10));
+		}
+		else if (strcmp(argv[arg], "-m") == 0 && arg + 1 < argc && strtoull(argv[arg + 1], nullptr, 10) != 0) {
+			query = Remainder;
+			modulus = strtoull(argv[++arg], nullptr, 10);
+		}
+		else if (strcmp(argv[arg], "-c") == 0 && arg + 1 < argc) {
+			variant = BinomialCoefficient;
+			k = static_cast<unsigned int>(strtoul(argv[++arg], nullptr, 10));
+		}
+		else if (strcmp(argv[arg], "-p") == 0 && arg + 1 < argc) {
+			variant = FallingProduct;
+			k = static_cast<unsigned int>(strtoul(argv[++arg], nullptr, 10));
+		}
+		else if (strcmp(argv[arg], "-e") == 0) {
+			variant = DoubleProduct;
+		}
+		else if (strcmp(argv[arg], "-u") == 0) {
+			variant = MultinomialCoefficient;
+		}
+		else {
+			cerr << "Usage: LargeFactorials [-s | -t] [-j threads] [-b [-k interval]] [-z | -d | -l count | -m modulus] [-c k | -p k | -e | -u]" << endl;
+			return 1;
+		}
+	}
+
+	if (query != AllDigits) {
+		return RunQuery(query, count, modulus, numThreads) ? 0 : 1;
+	}
+	if (variant != PlainFactorial) {
+		return RunVariant(variant, k, numThreads) ? 0 : 1;
+	}
+	if (batch) {
+		RunBatch(method, numThreads, interval);
+		return 0;
+	}
 
-int main() {
-	//  Input the parameter.
-	int n;
+	unsigned int n;
 	cin >> n;
 
 	//  Calculate the result.
-	vector<unsigned int> result;
-	Factorial(n, result);
+	BigUnsigned result;
+	Factorial(n, method, numThreads, result);
 
 	//  Output the result.
-	for (int i = result.size()-1; i >= 0; --i) {
-		cout << result[i];
-	}
-	cout << endl;
+	string text;
+	WriteResult(result, numThreads, text);
 
 	return 0;
 }
 
-void Factorial(const unsigned int n, vector<unsigned int> &result) {
-	//	Initialize result to "1".
-	result.clear();
-	result.push_back(1);
+//	Answers every N on the input, smallest first, so each can resume from the checkpoints the smaller ones left behind.
+void RunBatch(FactorialMethod method, unsigned int numThreads, unsigned int interval) {
+	vector<unsigned int> values;
+	unsigned int n;
+	while (cin >> n) {
+		values.push_back(n);
+	}
+	sort(values.begin(), values.end());
+	values.erase(unique(values.begin(), values.end()), values.end());
 
-	//	Factorial: 1 x 2 x ... x n-1 x n
-	for (unsigned int curN = 2; curN <= n; ++curN) {
-		Multiply(curN, result);
+	FactorialCache cache(interval, CHECKPOINT_CACHE_LIMBS);
+	BigUnsigned result;
+	string text;
+	for (unsigned int value : values) {
+		cache.Compute(value, method, numThreads, result);
+		cout << value << ' ';
+		WriteResult(result, numThreads, text);
 	}
+}
 
+//	Converts result to decimal in one buffer, text, and writes it and a newline in one call.
+void WriteResult(const BigUnsigned& result, unsigned int numThreads, string& text) {
+	ToDecimal(result, numThreads, text);
+	text.push_back('\n');
+	cout.write(text.data(), static_cast<streamsize>(text.size()));
 }
 
-//	Note: number is constructed backwards.
-//		For example, 42 is stored as num[0] = 2, num[1] = 4
-void Multiply(const unsigned int curN, vector<unsigned int>& num) {
-	char carry = 0;
-	
-	//	Multiply curN with each digit of num, carrying values greater than 10 forward to the next iteration.
-	for (unsigned int i = 0; i < num.size(); ++i) {
-		unsigned int product = (num[i] * curN) + carry;
-		num[i] = product % 10;
-		carry = product / 10;	//	Intentional integer division.
+//	Reads N and writes the one fact about N! that was asked for.
+bool RunQuery(FactorialQuery query, unsigned int count, uint64_t modulus, unsigned int numThreads) {
+	uint64_t n;
+	cin >> n;
+
+	switch (query) {
+		case TrailingZeros:
+			cout << CountTrailingZeros(n) << endl;
+			break;
+		case DigitCount:
+			if (n > FACTORIAL_DIGITS_LIMIT) {
+				cerr << "Digit counts are only given for N up to " << FACTORIAL_DIGITS_LIMIT << "." << endl;
+				return false;
+			}
+			cout << CountDigits(n) << endl;
+			break;
+		case Leading: {
+			string digits;
+			LeadingDigits(n, count, digits);
+			cout << digits << endl;
+			break;
+		}
+		case Remainder:
+			cout << FactorialMod(n, modulus, numThreads) << endl;
+			break;
+		case AllDigits:
+			break;
 	}
 
-	//	Apply any remaining carry to the final value.
-	while (carry > 0) {
-		num.push_back(carry % 10);
-		carry /= 10;			//	Intentional integer division.
+	return true;
+}
+
+//	Reads N, or the counts for -u, and writes the chosen relative of N!.
+bool RunVariant(FactorialVariant variant, unsigned int k, unsigned int numThreads) {
+	BigUnsigned result;
+	if (variant == MultinomialCoefficient) {
+		//	Multinomial() forms primes up to the sum of the counts, which must fit in an unsigned int.
+		vector<unsigned int> counts;
+		uint64_t sum = 0;
+		uint64_t count;
+		while (cin >> count) {
+			sum += count;
+			if (sum > numeric_limits<unsigned int>::max()) {
+				cerr << "The counts must sum to at most " << numeric_limits<unsigned int>::max() << "." << endl;
+				return false;
+			}
+			counts.push_back(static_cast<unsigned int>(count));
+		}
+		Multinomial(counts, numThreads, result);
 	}
+	else {
+		unsigned int n;
+		cin >> n;
+		switch (variant) {
+			case BinomialCoefficient:
+				Binomial(n, k, numThreads, result);
+				break;
+			case FallingProduct:
+				FallingFactorial(n, k, numThreads, result);
+				break;
+			case DoubleProduct:
+				DoubleFactorial(n, numThreads, result);
+				break;
+			case PlainFactorial:
+			case MultinomialCoefficient:
+				break;
+		}
+	}
+
+	string text;
+	WriteResult(result, numThreads, text);
+	return true;
 }
\ No newline at end of file
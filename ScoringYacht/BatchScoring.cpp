@@ -0,0 +1,260 @@
+#include <cstring>		//	for std::memcpy, std::memset
+#include "Constants.h"
+#include "BatchScoring.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>	//	for AVX2 intrinsics
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BATCH_SSE2
+#include <emmintrin.h>	//	for SSE2 intrinsics
+#endif
+
+//-------------------------------------------------------------
+//	LaneVector holds one 8-bit value per roll.  Comparisons return all ones in the lanes where they hold.
+#if defined(__AVX2__)
+typedef __m256i LaneVector;
+
+static inline LaneVector LoadLanes(const uint8_t* lanes) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lanes)); }
+static inline void StoreLanes(uint8_t* lanes, LaneVector v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), v); }
+static inline LaneVector Broadcast(uint8_t value) { return _mm256_set1_epi8(static_cast<char>(value)); }
+static inline LaneVector And(LaneVector a, LaneVector b) { return _mm256_and_si256(a, b); }
+static inline LaneVector Or(LaneVector a, LaneVector b) { return _mm256_or_si256(a, b); }
+static inline LaneVector AndNot(LaneVector a, LaneVector b) { return _mm256_andnot_si256(b, a); }
+static inline LaneVector Add(LaneVector a, LaneVector b) { return _mm256_add_epi8(a, b); }
+static inline LaneVector Subtract(LaneVector a, LaneVector b) { return _mm256_sub_epi8(a, b); }
+static inline LaneVector Equals(LaneVector a, LaneVector b) { return _mm256_cmpeq_epi8(a, b); }
+static inline LaneVector Min(LaneVector a, LaneVector b) { return _mm256_min_epu8(a, b); }
+static inline LaneVector Max(LaneVector a, LaneVector b) { return _mm256_max_epu8(a, b); }
+#elif defined(BATCH_SSE2)
+typedef __m128i LaneVector;
+
+static inline LaneVector LoadLanes(const uint8_t* lanes) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes)); }
+static inline void StoreLanes(uint8_t* lanes, LaneVector v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), v); }
+static inline LaneVector Broadcast(uint8_t value) { return _mm_set1_epi8(static_cast<char>(value)); }
+static inline LaneVector And(LaneVector a, LaneVector b) { return _mm_and_si128(a, b); }
+static inline LaneVector Or(LaneVector a, LaneVector b) { return _mm_or_si128(a, b); }
+static inline LaneVector AndNot(LaneVector a, LaneVector b) { return _mm_andnot_si128(b, a); }
+static inline LaneVector Add(LaneVector a, LaneVector b) { return _mm_add_epi8(a, b); }
+static inline LaneVector Subtract(LaneVector a, LaneVector b) { return _mm_sub_epi8(a, b); }
+static inline LaneVector Equals(LaneVector a, LaneVector b) { return _mm_cmpeq_epi8(a, b); }
+static inline LaneVector Min(LaneVector a, LaneVector b) { return _mm_min_epu8(a, b); }
+static inline LaneVector Max(LaneVector a, LaneVector b) { return _mm_max_epu8(a, b); }
+#else
+//	Plain C++ fallback, written as simple loops so the compiler can still vectorize it.
+struct LaneVector
+{
+	uint8_t lanes[BATCH_LANES];
+};
+
+static inline LaneVector LoadLanes(const uint8_t* lanes) { LaneVector r; for (unsigned int i = 0; i < BATCH_LANES; ++i) r.lanes[i] = lanes[i]; return r; }
+static inline void StoreLanes(uint8_t* lanes, LaneVector v) { for (unsigned int i = 0; i < BATCH_LANES; ++i) lanes[i] = v.lanes[i]; }
+static inline LaneVector Broadcast(uint8_t value) { LaneVector r; for (unsigned int i = 0; i < BATCH_LANES; ++i) r.lanes[i] = value; return r; }
+static inline LaneVector And(LaneVector a, LaneVector b) { for (unsigned int i = 0; i < BATCH_LANES; ++i) a.lanes[i] &= b.lanes[i]; return a; }
+static inline LaneVector Or(LaneVector a, LaneVector b) { for (unsigned int i = 0; i < BATCH_LANES; ++i) a.lanes[i] |= b.lanes[i]; return a; }
+static inline LaneVector AndNot(LaneVector a, LaneVector b) { for (unsigned int i = 0; i < BATCH_LANES; ++i) a.lanes[i] &= ~b.lanes[i]; return a; }
+static inline LaneVector Add(LaneVector a, LaneVector b) { for (unsigned int i = 0; i < BATCH_LANES; ++i) a.lanes[i] += b.lanes[i]; return a; }
+static inline LaneVector Subtract(LaneVector a, LaneVector b) { for (unsigned int i = 0; i < BATCH_LANES; ++i) a.lanes[i] -= b.lanes[i]; return a; }
+static inline LaneVector Equals(LaneVector a, LaneVector b) { for (unsigned int i = 0; i < BATCH_LANES; ++i) a.lanes[i] = (a.lanes[i] == b.lanes[i]) ? 0xFF : 0; return a; }
+static inline LaneVector Min(LaneVector a, LaneVector b) { for (unsigned int i = 0; i < BATCH_LANES; ++i) a.lanes[i] = (b.lanes[i] < a.lanes[i]) ? b.lanes[i] : a.lanes[i]; return a; }
+static inline LaneVector Max(LaneVector a, LaneVector b) { for (unsigned int i = 0; i < BATCH_LANES; ++i) a.lanes[i] = (b.lanes[i] > a.lanes[i]) ? b.lanes[i] : a.lanes[i]; return a; }
+#endif
+
+//	The kernels below are written out die by die: compilers leave short loops over vector registers rolled up at -O2, and
+//	the loop bookkeeping then costs more than the scoring.
+static_assert(NUM_DICE == 5 && MAX_DIE_VALUE == 6, "The lane kernels are written out for five six-sided dice");
+
+//	Five different faces out of six leave one out, so their sum tells which straight they are.
+const uint8_t LITTLE_STRAIGHT_SUM = 1 + 2 + 3 + 4 + 5;
+const uint8_t BIG_STRAIGHT_SUM = 2 + 3 + 4 + 5 + 6;
+
+//	Counts of matching pairs of dice, which tell the shapes of roll apart (see CountMatchingPairs()).
+const uint8_t PAIRS_FULL_HOUSE = 4;
+const uint8_t PAIRS_FOUR_OF_A_KIND = 6;
+const uint8_t PAIRS_YACHT = 10;
+
+//	Returns all ones in the lanes where every die holds a legal value.
+static inline LaneVector IsRollValid(const LaneVector* dice)
+{
+	LaneVector lowest = Min(Min(Min(dice[0], dice[1]), Min(dice[2], dice[3])), dice[4]);
+	LaneVector highest = Max(Max(Max(dice[0], dice[1]), Max(dice[2], dice[3])), dice[4]);
+	return And(Equals(Max(lowest, Broadcast(MIN_DIE_VALUE)), lowest), Equals(Min(highest, Broadcast(MAX_DIE_VALUE)), highest));
+}
+
+static inline LaneVector SumDice(const LaneVector* dice)
+{
+	return Add(Add(Add(dice[0], dice[1]), Add(dice[2], dice[3])), dice[4]);
+}
+
+//	Returns how many of the ten pairs of dice show the same value: 10 for a yacht, 6 for four of a kind, 4 for a full
+//	house, 3 for three of a kind, 2 for two pairs, 1 for one pair, and 0 when every die differs.
+static inline LaneVector CountMatchingPairs(const LaneVector* dice)
+{
+	//	A match is all ones, i.e., -1, so the sum of the matches counts down.
+	LaneVector first = Add(Add(Equals(dice[0], dice[1]), Equals(dice[0], dice[2])), Add(Equals(dice[0], dice[3]), Equals(dice[0], dice[4])));
+	LaneVector second = Add(Add(Equals(dice[1], dice[2]), Equals(dice[1], dice[3])), Equals(dice[1], dice[4]));
+	LaneVector rest = Add(Add(Equals(dice[2], dice[3]), Equals(dice[2], dice[4])), Equals(dice[3], dice[4]));
+	return Subtract(Broadcast(0), Add(Add(first, second), rest));
+}
+
+//	Returns the face's count times the face, adding up the matching dice themselves, since there's no byte multiply.
+static inline LaneVector ScoreSinglesLanes(const LaneVector* dice, uint8_t face)
+{
+	const LaneVector value = Broadcast(face);
+	LaneVector first = Add(And(Equals(dice[0], value), value), And(Equals(dice[1], value), value));
+	LaneVector second = Add(And(Equals(dice[2], value), value), And(Equals(dice[3], value), value));
+	return Add(Add(first, second), And(Equals(dice[4], value), value));
+}
+
+static inline LaneVector ScoreFourOfAKindLanes(const LaneVector* dice, LaneVector pairs, LaneVector sum)
+{
+	//	With four or more dice alike, at least two of any three show the common face: the first die, unless it matches
+	//	neither of the next two.
+	LaneVector firstIsCommon = Or(Equals(dice[0], dice[1]), Equals(dice[0], dice[2]));
+	LaneVector face = Or(And(firstIsCommon, dice[0]), AndNot(dice[1], firstIsCommon));
+	LaneVector twice = Add(face, face);
+
+	//	A yacht scores all five dice, which is just their sum.
+	LaneVector four = And(Equals(pairs, Broadcast(PAIRS_FOUR_OF_A_KIND)), Add(twice, twice));
+	LaneVector five = And(Equals(pairs, Broadcast(PAIRS_YACHT)), sum);
+	return Or(four, five);
+}
+
+static inline LaneVector ScoreFullHouseLanes(LaneVector pairs, LaneVector sum)
+{
+	return And(Equals(pairs, Broadcast(PAIRS_FULL_HOUSE)), sum);
+}
+
+static inline LaneVector ScoreStraightLanes(LaneVector pairs, LaneVector sum, uint8_t straightSum, uint8_t score)
+{
+	LaneVector isStraight = And(Equals(pairs, Broadcast(0)), Equals(sum, Broadcast(straightSum)));
+	return And(isStraight, Broadcast(score));
+}
+
+static inline LaneVector ScoreYachtLanes(LaneVector pairs)
+{
+	return And(Equals(pairs, Broadcast(PAIRS_YACHT)), Broadcast(SCORE_YACHT));
+}
+
+//	Scores one register's worth of rolls in one category, working out only what that category needs.
+//		Counts never pass NUM_DICE, so every score fits its byte: the highest is SCORE_YACHT.  A roll with an invalid die
+//		scores 0 in every category.
+static inline LaneVector ScoreCategoryLanes(const LaneVector* dice, Category category)
+{
+	LaneVector valid = IsRollValid(dice);
+	switch (category)
+	{
+		case Ones:
+		case Twos:
+		case Threes:
+		case Fours:
+		case Fives:
+		case Sixes:				return And(ScoreSinglesLanes(dice, static_cast<uint8_t>(category + 1)), valid);
+		case FourOfAKind:		return And(ScoreFourOfAKindLanes(dice, CountMatchingPairs(dice), SumDice(dice)), valid);
+		case FullHouse:			return And(ScoreFullHouseLanes(CountMatchingPairs(dice), SumDice(dice)), valid);
+		case LittleStraight:	return And(ScoreStraightLanes(CountMatchingPairs(dice), SumDice(dice), LITTLE_STRAIGHT_SUM, SCORE_LITTLE_STRAIGHT), valid);
+		case BigStraight:		return And(ScoreStraightLanes(CountMatchingPairs(dice), SumDice(dice), BIG_STRAIGHT_SUM, SCORE_BIG_STRAIGHT), valid);
+		case Choice:			return And(SumDice(dice), valid);
+		case Yacht:				return And(ScoreYachtLanes(CountMatchingPairs(dice)), valid);
+		default:				return Broadcast(0);
+	}
+}
+
+//	Scores one register's worth of rolls in every category, sharing the work the categories have in common.
+static inline void ScoreAllLanes(const LaneVector* dice, LaneVector* results)
+{
+	LaneVector valid = IsRollValid(dice);
+	LaneVector sum = SumDice(dice);
+	LaneVector pairs = CountMatchingPairs(dice);
+
+	results[Ones] = And(ScoreSinglesLanes(dice, 1), valid);
+	results[Twos] = And(ScoreSinglesLanes(dice, 2), valid);
+	results[Threes] = And(ScoreSinglesLanes(dice, 3), valid);
+	results[Fours] = And(ScoreSinglesLanes(dice, 4), valid);
+	results[Fives] = And(ScoreSinglesLanes(dice, 5), valid);
+	results[Sixes] = And(ScoreSinglesLanes(dice, 6), valid);
+	results[FourOfAKind] = And(ScoreFourOfAKindLanes(dice, pairs, sum), valid);
+	results[FullHouse] = And(ScoreFullHouseLanes(pairs, sum), valid);
+	results[LittleStraight] = And(ScoreStraightLanes(pairs, sum, LITTLE_STRAIGHT_SUM, SCORE_LITTLE_STRAIGHT), valid);
+	results[BigStraight] = And(ScoreStraightLanes(pairs, sum, BIG_STRAIGHT_SUM, SCORE_BIG_STRAIGHT), valid);
+	results[Choice] = And(sum, valid);
+	results[Yacht] = And(ScoreYachtLanes(pairs), valid);
+}
+
+static inline void LoadDice(const RollColumns& rolls, size_t offset, LaneVector* dice)
+{
+	for (unsigned int die = 0; die < NUM_DICE; ++die)
+	{
+		dice[die] = LoadLanes(rolls.dice[die] + offset);
+	}
+}
+
+//	Loads the last few rolls into a full register's worth of zeros, which score as invalid rolls.
+static inline void LoadPartialDice(const RollColumns& rolls, size_t offset, LaneVector* dice)
+{
+	uint8_t lanes[BATCH_LANES];
+	for (unsigned int die = 0; die < NUM_DICE; ++die)
+	{
+		std::memset(lanes, 0, BATCH_LANES);
+		std::memcpy(lanes, rolls.dice[die] + offset, rolls.count - offset);
+		dice[die] = LoadLanes(lanes);
+	}
+}
+
+static inline void StorePartialLanes(uint8_t* scores, LaneVector v, size_t count)
+{
+	uint8_t lanes[BATCH_LANES];
+	StoreLanes(lanes, v);
+	std::memcpy(scores, lanes, count);
+}
+//-------------------------------------------------------------
+
+//	Calculate the scores of a batch of rolls for the given scoring category, BATCH_LANES rolls at a time.
+void GetScores(Category category, const RollColumns& rolls, uint8_t* scores)
+{
+	LaneVector dice[NUM_DICE];
+	size_t offset = 0;
+	for (; offset + BATCH_LANES <= rolls.count; offset += BATCH_LANES)
+	{
+		LoadDice(rolls, offset, dice);
+		StoreLanes(scores + offset, ScoreCategoryLanes(dice, category));
+	}
+
+	if (offset < rolls.count)
+	{
+		LoadPartialDice(rolls, offset, dice);
+		StorePartialLanes(scores + offset, ScoreCategoryLanes(dice, category), rolls.count - offset);
+	}
+}
+
+//	Calculate the scores of a batch of rolls for every scoring category, BATCH_LANES rolls at a time.
+void GetAllScores(const RollColumns& rolls, const ScoreColumns& scores)
+{
+	LaneVector dice[NUM_DICE];
+	LaneVector results[NUM_CATEGORIES];
+	size_t offset = 0;
+	for (; offset + BATCH_LANES <= rolls.count; offset += BATCH_LANES)
+	{
+		LoadDice(rolls, offset, dice);
+		ScoreAllLanes(dice, results);
+		for (unsigned int category = Category::Ones; category < Category::MAXVALUE; ++category)
+		{
+			if (scores[category] != nullptr)
+			{
+				StoreLanes(scores[category] + offset, results[category]);
+			}
+		}
+	}
+
+	if (offset < rolls.count)
+	{
+		LoadPartialDice(rolls, offset, dice);
+		ScoreAllLanes(dice, results);
+		for (unsigned int category = Category::Ones; category < Category::MAXVALUE; ++category)
+		{
+			if (scores[category] != nullptr)
+			{
+				StorePartialLanes(scores[category] + offset, results[category], rolls.count - offset);
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+#ifndef BATCHSCORING_H
+#define BATCHSCORING_H
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "Constants.h"
+
+//	Number of rolls scored side by side: one per 8-bit lane of the widest vector register available.
+//		AVX2 holds 32 rolls per register; SSE2 (and the plain C++ fallback) holds 16.
+#if defined(__AVX2__)
+const unsigned int BATCH_LANES = 32;
+#else
+const unsigned int BATCH_LANES = 16;
+#endif
+
+//	A batch of rolls laid out die by die: dice[die][i] is that die's value in roll i.
+struct RollColumns
+{
+	std::array<const uint8_t*, NUM_DICE> dice;
+	size_t count;
+};
+
+//	One output array of count scores per category, indexed by Category.  Null entries are skipped.
+typedef std::array<uint8_t*, NUM_CATEGORIES> ScoreColumns;
+
+//	Interface functions
+//		Write each roll's score in the given category to scores[i].  Unlike GetScore(), invalid rolls score 0 silently.
+void GetScores(Category category, const RollColumns& rolls, uint8_t* scores);
+//		Write each roll's score in every category with a non-null column.
+void GetAllScores(const RollColumns& rolls, const ScoreColumns& scores);
+
+#endif	//	BATCHSCORING_H
\ No newline at end of file
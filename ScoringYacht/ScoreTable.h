@@ -0,0 +1,254 @@
+#ifndef SCORETABLE_H
+#define SCORETABLE_H
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include "Constants.h"
+
+//	Number of distinct rolls once the order of the dice is ignored: multisets of NUM_DICE values from MAX_DIE_VALUE faces.
+const unsigned int NUM_ROLL_KINDS = 252;
+
+//	Every category's score for one kind of roll.
+struct RollScores
+{
+	std::array<uint8_t, NUM_CATEGORIES> scores;
+};
+
+//	Indexed by GetRollIndex().  252 rows of 12 bytes, small enough to stay in L1.
+typedef std::array<RollScores, NUM_ROLL_KINDS> ScoreTable;
+
+//	Indexed by [face][dice not yet counted][count of this face]; see GetRollIndex().
+typedef std::array<std::array<std::array<uint8_t, NUM_DICE + 1>, NUM_DICE + 1>, MAX_DIE_VALUE> RollIndexOffsets;
+
+//	Scoring rules.  All are constexpr so that the score table can be built from them at compile time.
+//		Calculate score of singles categories (Ones, Twos, ..., Sixes).
+constexpr unsigned int ScoreSingles(const RollMap& rollMap, Category category)
+{
+	//	Category is a 0-base enumeration, so it's representative value is off by one.
+	return (category + 1) * rollMap[category];
+}
+
+//		Calculate the sum of all values in the roll map.
+constexpr unsigned int CalculateSum(const RollMap& rollMap)
+{
+	unsigned int sum = 0;
+	for (unsigned int i = 0; i < MAX_DIE_VALUE; ++i)
+	{
+		//	Add to the sum the product of the value at this index and it's category (which is its index + 1).
+		sum += rollMap[i] * (i + 1);
+	}
+
+	return sum;
+}
+
+//		Determine if any value is duplicated x times in the roll.
+//			Returns the die value that is repeated x times in the roll, or 0 if no value is repeated x times.
+constexpr unsigned int HasXOfAKind(const RollMap& rollMap, const unsigned int x)
+{
+	for (unsigned int i = 0; i < MAX_DIE_VALUE; ++i)
+	{
+		if (rollMap[i] >= x)
+		{
+			return i + 1;
+		}
+	}
+
+	return 0;
+}
+
+//		Return the highest number of consecutive values in the roll map.
+constexpr unsigned int GetMaxStraightLength(const RollMap& rollMap)
+{
+	unsigned int maxSequenceLength = 0;
+	unsigned int curSequenceLength = 0;
+	for (unsigned int i = 0; i < MAX_DIE_VALUE; ++i)
+	{
+		//	A missing value ends the sequence; any other continues it.
+		curSequenceLength = (rollMap[i] == 0) ? 0 : curSequenceLength + 1;
+		if (curSequenceLength > maxSequenceLength)
+		{
+			maxSequenceLength = curSequenceLength;
+		}
+	}
+
+	return maxSequenceLength;
+}
+
+//		Calculate score of four of a kind.
+constexpr unsigned int ScoreFourOfAKind(const RollMap& rollMap)
+{
+	unsigned int matchingValue = HasXOfAKind(rollMap, 4);
+	if (matchingValue == 0)
+	{
+		return 0;
+	}
+
+	return ScoreSingles(rollMap, static_cast<Category>(matchingValue - 1));
+}
+
+//		Calculate score of a full house (three of one value, two of another).
+constexpr unsigned int ScoreFullHouse(const RollMap& rollMap)
+{
+	bool foundPair = false;
+	bool foundTrio = false;
+	for (unsigned int i = 0; i < MAX_DIE_VALUE; ++i)
+	{
+		foundTrio = foundTrio || rollMap[i] == 3;
+		foundPair = foundPair || rollMap[i] == 2;
+	}
+
+	return (foundTrio && foundPair) ? CalculateSum(rollMap) : 0;
+}
+
+//		Calculate score of a little straight (lowest value straight possible, i.e., 1-2-3-4-5).
+constexpr unsigned int ScoreLittleStraight(const RollMap& rollMap)
+{
+	return (rollMap[0] != 0 && GetMaxStraightLength(rollMap) == NUM_DICE) ? SCORE_LITTLE_STRAIGHT : 0;
+}
+
+//		Calculate score of a big straight (highest value straight possible, i.e., 2-3-4-5-6).
+constexpr unsigned int ScoreBigStraight(const RollMap& rollMap)
+{
+	return (rollMap[MAX_DIE_VALUE - 1] != 0 && GetMaxStraightLength(rollMap) == NUM_DICE) ? SCORE_BIG_STRAIGHT : 0;
+}
+
+//		Calculate score of Choice.
+constexpr unsigned int ScoreChoice(const RollMap& rollMap)
+{
+	return CalculateSum(rollMap);
+}
+
+//		Calculate score for all values being the same.
+constexpr unsigned int ScoreYacht(const RollMap& rollMap)
+{
+	return (HasXOfAKind(rollMap, NUM_DICE) != 0) ? SCORE_YACHT : 0;
+}
+
+//		Calculate the score of a roll map for the given scoring category.
+constexpr unsigned int ScoreRollMap(const RollMap& rollMap, Category category)
+{
+	switch (category)
+	{
+		case Ones:				return ScoreSingles(rollMap, Ones);
+		case Twos:				return ScoreSingles(rollMap, Twos);
+		case Threes:			return ScoreSingles(rollMap, Threes);
+		case Fours:				return ScoreSingles(rollMap, Fours);
+		case Fives:				return ScoreSingles(rollMap, Fives);
+		case Sixes:				return ScoreSingles(rollMap, Sixes);
+		case FourOfAKind:		return ScoreFourOfAKind(rollMap);
+		case FullHouse:			return ScoreFullHouse(rollMap);
+		case LittleStraight:	return ScoreLittleStraight(rollMap);
+		case BigStraight:		return ScoreBigStraight(rollMap);
+		case Choice:			return ScoreChoice(rollMap);
+		case Yacht:				return ScoreYacht(rollMap);
+		default:				return 0;
+	}
+}
+
+//	Table construction.
+//		Number of ways to spread dice among faces, ignoring order: C(dice + faces - 1, faces - 1).
+constexpr unsigned int CountRollKinds(unsigned int dice, unsigned int faces)
+{
+	if (faces == 0)
+	{
+		return (dice == 0) ? 1 : 0;
+	}
+
+	unsigned int count = 1;
+	for (unsigned int i = 1; i < faces; ++i)
+	{
+		//	Each partial product is itself a binomial coefficient, so the division is exact.
+		count = count * (dice + i) / i;
+	}
+
+	return count;
+}
+
+//		Kinds of roll are ranked face by face: with r dice left to place, every arrangement that puts more than c of them
+//		on this face comes before those that put exactly c, and there are CountRollKinds(r - j, faces after this one) with
+//		exactly j.  offsets[face][r][c] sums those counts over j = c + 1 ... r.
+constexpr RollIndexOffsets BuildRollIndexOffsets()
+{
+	RollIndexOffsets offsets = {};
+	for (unsigned int face = 0; face < MAX_DIE_VALUE; ++face)
+	{
+		for (unsigned int remaining = 0; remaining <= NUM_DICE; ++remaining)
+		{
+			for (unsigned int count = 0; count <= remaining; ++count)
+			{
+				unsigned int offset = 0;
+				for (unsigned int j = count + 1; j <= remaining; ++j)
+				{
+					offset += CountRollKinds(remaining - j, MAX_DIE_VALUE - face - 1);
+				}
+				offsets[face][remaining][count] = static_cast<uint8_t>(offset);
+			}
+		}
+	}
+
+	return offsets;
+}
+
+constexpr RollIndexOffsets ROLL_INDEX_OFFSETS = BuildRollIndexOffsets();
+
+//		Return the rank of a roll map among all NUM_ROLL_KINDS kinds of roll: one table load per face.
+constexpr unsigned int GetRollIndex(const RollMap& rollMap)
+{
+	unsigned int index = 0;
+	unsigned int remaining = NUM_DICE;
+	for (unsigned int face = 0; face < MAX_DIE_VALUE; ++face)
+	{
+		index += ROLL_INDEX_OFFSETS[face][remaining][rollMap[face]];
+		remaining -= rollMap[face];
+	}
+
+	return index;
+}
+
+//		Score every kind of roll in every category, visiting each once as a sorted roll: 1-1-1-1-1, 1-1-1-1-2, ..., 6-6-6-6-6.
+constexpr ScoreTable BuildScoreTable()
+{
+	ScoreTable table = {};
+	Roll roll = { 1, 1, 1, 1, 1 };
+	for (;;)
+	{
+		RollMap rollMap = { 0, 0, 0, 0, 0, 0 };
+		for (unsigned int i = 0; i < NUM_DICE; ++i)
+		{
+			rollMap[roll[i] - 1]++;
+		}
+
+		RollScores& row = table[GetRollIndex(rollMap)];
+		for (unsigned int curCategory = Category::Ones; curCategory < Category::MAXVALUE; ++curCategory)
+		{
+			row.scores[curCategory] = static_cast<uint8_t>(ScoreRollMap(rollMap, static_cast<Category>(curCategory)));
+		}
+
+		//	Advance to the next sorted roll: bump the last die that can go higher, and level the ones after it with it.
+		unsigned int die = NUM_DICE;
+		while (die > 0 && roll[die - 1] == MAX_DIE_VALUE)
+		{
+			--die;
+		}
+		if (die == 0)
+		{
+			break;
+		}
+
+		roll[die - 1]++;
+		for (unsigned int i = die; i < NUM_DICE; ++i)
+		{
+			roll[i] = roll[die - 1];
+		}
+	}
+
+	return table;
+}
+
+static_assert(CountRollKinds(NUM_DICE, MAX_DIE_VALUE) == NUM_ROLL_KINDS, "NUM_ROLL_KINDS must count every kind of roll");
+
+//	Every category's score for every kind of roll, worked out once by the compiler and shared by every translation unit.
+inline constexpr ScoreTable SCORE_TABLE = BuildScoreTable();
+
+#endif	//	SCORETABLE_H
\ No newline at end of file
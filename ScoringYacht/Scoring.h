@@ -3,24 +3,17 @@
 #pragma once
 
 #include "Constants.h"
+#include "ScoreTable.h"
+#include "Strategy.h"
 
 //	Interface functions
 unsigned int GetScore(Category category, const Roll& roll);
+//		GetSuggestion() takes the categories already used; without them, it assumes an empty scorecard.
+Category GetSuggestion(CategoryMask used, const Roll& roll);
 Category GetSuggestion(const Roll& roll);
 
 //	Helper functions
-unsigned int ScoreSingles(const RollMap& rollMap, Category category);
-unsigned int ScoreFourOfAKind(const RollMap& rollMap);
-unsigned int ScoreFullHouse(const RollMap& rollMap);
-unsigned int ScoreLittleStraight(const RollMap& rollMap);
-unsigned int ScoreBigStraight(const RollMap& rollMap);
-unsigned int ScoreChoice(const RollMap& rollMap);
-unsigned int ScoreYacht(const RollMap& rollMap);
-
-unsigned int CalculateSum(const RollMap& rollMap);
-unsigned int HasXOfAKind(const RollMap& rollMap, const unsigned int x);
-unsigned int GetMaxStraightLength(const RollMap& rollMap);
-
+//		The scoring rules themselves are constexpr, in ScoreTable.h.
 void FillRollMap(RollMap& rollMap, const Roll& roll);
 bool IsRollValid(const Roll& thisRoll);
 bool IsValueValid(unsigned int value);
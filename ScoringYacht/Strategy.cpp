@@ -0,0 +1,338 @@
+#include <algorithm>	//	for std::max
+#include <map>			//	for std::map
+#include <thread>		//	for std::thread
+#include "Constants.h"
+#include "Scoring.h"
+#include "Strategy.h"
+
+//	Solve the game a layer at a time, from the last turn back to the first.
+void SolveStrategy(unsigned int numThreads, StrategyTable& strategy)
+{
+	if (numThreads == 0)
+	{
+		numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+	}
+
+	//	Build the shared tables before the threads need them.
+	GetTransitions();
+
+	//	Sort the states into layers by how many categories have been used.
+	std::array<std::vector<CategoryMask>, NUM_CATEGORIES + 1> layers;
+	for (unsigned int used = 0; used < NUM_CATEGORY_MASKS; ++used)
+	{
+		unsigned int count = 0;
+		for (unsigned int category = Category::Ones; category < Category::MAXVALUE; ++category)
+		{
+			count += (used >> category) & 1;
+		}
+		layers[count].push_back(static_cast<CategoryMask>(used));
+	}
+
+	//	With every category used, the game is over.
+	strategy.values.assign(NUM_CATEGORY_MASKS, 0.0);
+
+	for (unsigned int layer = NUM_CATEGORIES; layer-- > 0; )
+	{
+		std::atomic<size_t> next(0);
+		std::vector<std::thread> workers;
+		for (unsigned int i = 1; i < numThreads; ++i)
+		{
+			workers.push_back(std::thread(RunLayerWorker, &next, &layers[layer], &strategy));
+		}
+		RunLayerWorker(&next, &layers[layer], &strategy);
+		for (std::thread& worker : workers)
+		{
+			worker.join();
+		}
+	}
+}
+
+//	Solves states of one layer, taking them one at a time until there are none left.  Each state reads only the layer
+//	after it, which is finished, and writes only its own value.
+void RunLayerWorker(std::atomic<size_t>* next, const std::vector<CategoryMask>* masks, StrategyTable* strategy)
+{
+	const TransitionTable& transitions = GetTransitions();
+	TurnValues turn;
+	for (size_t index = (*next)++; index < masks->size(); index = (*next)++)
+	{
+		CategoryMask used = (*masks)[index];
+		SolveTurn(used, *strategy, NUM_REROLLS, turn);
+
+		//	The turn's first roll is a reroll of all the dice.
+		strategy->values[used] = ExpectKeep(transitions, transitions.emptyKeep, turn.rolls[NUM_REROLLS]);
+	}
+}
+
+const StrategyTable& GetStrategy()
+{
+	//	Function-local statics are initialized once, even with several threads asking at the same time.
+	struct SolvedStrategy
+	{
+		SolvedStrategy()
+		{
+			SolveStrategy(0, strategy);
+		}
+
+		StrategyTable strategy;
+	};
+
+	static const SolvedStrategy solved;
+	return solved.strategy;
+}
+
+double GetExpectedScore(CategoryMask used, const Roll& roll, unsigned int rerollsLeft)
+{
+	TurnValues turn;
+	SolveTurn(used, GetStrategy(), rerollsLeft, turn);
+	return turn.rolls[rerollsLeft][GetRollKind(roll)];
+}
+
+//	Score the category that leaves the most: its score now, plus what the rest of the game is worth without it.
+//		Ties go to the later category, as GetSuggestion() has always done.
+Category GetOptimalCategory(CategoryMask used, const Roll& roll)
+{
+	const StrategyTable& strategy = GetStrategy();
+	const RollScores& row = SCORE_TABLE[GetRollKind(roll)];
+
+	Category bestCategory = Category::MAXVALUE;
+	double bestValue = 0.0;
+	for (unsigned int category = Category::Ones; category < Category::MAXVALUE; ++category)
+	{
+		CategoryMask bit = static_cast<CategoryMask>(1 << category);
+		if ((used & bit) != 0)
+		{
+			continue;
+		}
+
+		double value = row.scores[category] + strategy.values[used | bit];
+		if (bestCategory == Category::MAXVALUE || value >= bestValue)
+		{
+			bestCategory = static_cast<Category>(category);
+			bestValue = value;
+		}
+	}
+
+	return bestCategory;
+}
+
+//	Hold the keep that's worth the most to reroll around.  Holding everything wins ties, so dice are only rerolled when
+//	that's strictly better.
+KeptDice GetOptimalKeep(CategoryMask used, const Roll& roll, unsigned int rerollsLeft)
+{
+	KeptDice kept;
+	kept.fill(true);
+	if (rerollsLeft == 0)
+	{
+		return kept;
+	}
+
+	const TransitionTable& transitions = GetTransitions();
+	TurnValues turn;
+	SolveTurn(used, GetStrategy(), rerollsLeft - 1, turn);
+
+	unsigned int rollKind = GetRollKind(roll);
+	unsigned int bestKeep = transitions.wholeKeeps[rollKind];
+	double bestValue = ExpectKeep(transitions, bestKeep, turn.rolls[rerollsLeft - 1]);
+	for (unsigned int i = transitions.keepStarts[rollKind]; i < transitions.keepStarts[rollKind + 1]; ++i)
+	{
+		unsigned int keep = transitions.keeps[i];
+		double value = ExpectKeep(transitions, keep, turn.rolls[rerollsLeft - 1]);
+		if (value > bestValue)
+		{
+			bestKeep = keep;
+			bestValue = value;
+		}
+	}
+
+	//	Hold the first dice of each value, as many as the keep has.
+	RollMap toKeep = transitions.keepMaps[bestKeep];
+	for (unsigned int i = 0; i < NUM_DICE; ++i)
+	{
+		kept[i] = toKeep[roll[i] - 1] > 0;
+		if (kept[i])
+		{
+			toKeep[roll[i] - 1]--;
+		}
+	}
+
+	return kept;
+}
+
+const TransitionTable& GetTransitions()
+{
+	static const TransitionTable transitions;
+	return transitions;
+}
+
+//	Works out a turn's values backwards from its last roll: with no rerolls left, a roll is worth its best category; with
+//	some left, it's worth the best of its keeps, and a keep is worth the average over everything it can be rerolled into.
+void SolveTurn(CategoryMask used, const StrategyTable& strategy, unsigned int rerollsLeft, TurnValues& turn)
+{
+	const TransitionTable& transitions = GetTransitions();
+
+	//	The value of scoring each open category, less that category's score, which depends on the roll.
+	std::array<double, NUM_CATEGORIES> remaining;
+	for (unsigned int category = Category::Ones; category < Category::MAXVALUE; ++category)
+	{
+		CategoryMask bit = static_cast<CategoryMask>(1 << category);
+		remaining[category] = ((used & bit) == 0) ? strategy.values[used | bit] : -1.0;
+	}
+
+	for (unsigned int rollKind = 0; rollKind < NUM_ROLL_KINDS; ++rollKind)
+	{
+		//	With every category used there's nothing left to score, and the turn is worth nothing.
+		double best = (used == ALL_CATEGORIES) ? 0.0 : -1.0;
+		for (unsigned int category = Category::Ones; category < Category::MAXVALUE; ++category)
+		{
+			if (remaining[category] >= 0.0)
+			{
+				best = std::max(best, SCORE_TABLE[rollKind].scores[category] + remaining[category]);
+			}
+		}
+		turn.rolls[0][rollKind] = best;
+	}
+
+	for (unsigned int stage = 1; stage <= rerollsLeft; ++stage)
+	{
+		for (unsigned int keep = 0; keep < NUM_KEEP_KINDS; ++keep)
+		{
+			turn.keeps[stage - 1][keep] = ExpectKeep(transitions, keep, turn.rolls[stage - 1]);
+		}
+
+		for (unsigned int rollKind = 0; rollKind < NUM_ROLL_KINDS; ++rollKind)
+		{
+			double best = 0.0;
+			for (unsigned int i = transitions.keepStarts[rollKind]; i < transitions.keepStarts[rollKind + 1]; ++i)
+			{
+				best = std::max(best, turn.keeps[stage - 1][transitions.keeps[i]]);
+			}
+			turn.rolls[stage][rollKind] = best;
+		}
+	}
+}
+
+//	Average the values of the rolls that rerolling around keep can end at.
+double ExpectKeep(const TransitionTable& transitions, unsigned int keep, const std::array<double, NUM_ROLL_KINDS>& rolls)
+{
+	double expected = 0.0;
+	for (unsigned int i = transitions.outcomeStarts[keep]; i < transitions.outcomeStarts[keep + 1]; ++i)
+	{
+		expected += transitions.outcomes[i].probability * rolls[transitions.outcomes[i].roll];
+	}
+
+	return expected;
+}
+
+unsigned int GetRollKind(const Roll& roll)
+{
+	RollMap rollMap = { 0, 0, 0, 0, 0, 0 };
+	FillRollMap(rollMap, roll);
+	return GetRollIndex(rollMap);
+}
+
+//	Numbers every keep, then lists each keep's outcomes and each roll's keeps by their numbers.
+TransitionTable::TransitionTable()
+{
+	//	Every count of each face from 0 to NUM_DICE, as a base-(NUM_DICE + 1) number, keeping those with few enough dice.
+	unsigned int numMaps = 1;
+	for (unsigned int face = 0; face < MAX_DIE_VALUE; ++face)
+	{
+		numMaps *= NUM_DICE + 1;
+	}
+
+	std::map<RollMap, uint16_t> keepIndices;
+	std::array<unsigned int, NUM_KEEP_KINDS> keepSizes;
+	for (unsigned int code = 0; code < numMaps; ++code)
+	{
+		RollMap keepMap;
+		unsigned int size = 0;
+		unsigned int rest = code;
+		for (unsigned int face = 0; face < MAX_DIE_VALUE; ++face)
+		{
+			keepMap[face] = rest % (NUM_DICE + 1);
+			rest /= NUM_DICE + 1;
+			size += keepMap[face];
+		}
+
+		if (size <= NUM_DICE)
+		{
+			uint16_t keep = static_cast<uint16_t>(keepIndices.size());
+			keepIndices[keepMap] = keep;
+			keepMaps[keep] = keepMap;
+			keepSizes[keep] = size;
+		}
+	}
+
+	emptyKeep = keepIndices[RollMap{ 0, 0, 0, 0, 0, 0 }];
+
+	//	Rerolling n dice lands on each kind of n-dice roll with probability n! / (c1! * ... * c6!) / 6^n.
+	const std::array<double, NUM_DICE + 1> factorials = { 1.0, 1.0, 2.0, 6.0, 24.0, 120.0 };
+	std::array<double, NUM_DICE + 1> waysToRoll;
+	waysToRoll[0] = 1.0;
+	for (unsigned int n = 1; n <= NUM_DICE; ++n)
+	{
+		waysToRoll[n] = waysToRoll[n - 1] * MAX_DIE_VALUE;
+	}
+
+	for (unsigned int keep = 0; keep < NUM_KEEP_KINDS; ++keep)
+	{
+		outcomeStarts[keep] = static_cast<uint16_t>(outcomes.size());
+		unsigned int rerolled = NUM_DICE - keepSizes[keep];
+		for (unsigned int outcome = 0; outcome < NUM_KEEP_KINDS; ++outcome)
+		{
+			if (keepSizes[outcome] != rerolled)
+			{
+				continue;
+			}
+
+			RollMap rollMap;
+			double probability = factorials[rerolled] / waysToRoll[rerolled];
+			for (unsigned int face = 0; face < MAX_DIE_VALUE; ++face)
+			{
+				rollMap[face] = keepMaps[keep][face] + keepMaps[outcome][face];
+				probability /= factorials[keepMaps[outcome][face]];
+			}
+
+			Transition transition;
+			transition.roll = static_cast<uint8_t>(GetRollIndex(rollMap));
+			transition.probability = probability;
+			outcomes.push_back(transition);
+		}
+	}
+	outcomeStarts[NUM_KEEP_KINDS] = static_cast<uint16_t>(outcomes.size());
+
+	//	A roll's keeps are every way of holding some of each of its faces; different ways never hold the same dice.
+	for (unsigned int keep = 0; keep < NUM_KEEP_KINDS; ++keep)
+	{
+		if (keepSizes[keep] == NUM_DICE)
+		{
+			wholeKeeps[GetRollIndex(keepMaps[keep])] = static_cast<uint16_t>(keep);
+		}
+	}
+
+	for (unsigned int rollKind = 0; rollKind < NUM_ROLL_KINDS; ++rollKind)
+	{
+		keepStarts[rollKind] = static_cast<uint16_t>(keeps.size());
+		const RollMap& rollMap = keepMaps[wholeKeeps[rollKind]];
+
+		RollMap keepMap = { 0, 0, 0, 0, 0, 0 };
+		for (;;)
+		{
+			keeps.push_back(keepIndices[keepMap]);
+
+			//	Count up through the holds like an odometer, each face wheel going from 0 to that face's count.
+			unsigned int face = 0;
+			while (face < MAX_DIE_VALUE && keepMap[face] == rollMap[face])
+			{
+				keepMap[face] = 0;
+				++face;
+			}
+			if (face == MAX_DIE_VALUE)
+			{
+				break;
+			}
+			keepMap[face]++;
+		}
+	}
+	keepStarts[NUM_ROLL_KINDS] = static_cast<uint16_t>(keeps.size());
+}
\ No newline at end of file
@@ -0,0 +1,95 @@
+#ifndef STRATEGY_H
+#define STRATEGY_H
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Constants.h"
+#include "ScoreTable.h"
+
+//	The categories already scored in a game: bit c is set once category c has been used.
+typedef uint16_t CategoryMask;
+const unsigned int NUM_CATEGORY_MASKS = 1 << NUM_CATEGORIES;
+const CategoryMask ALL_CATEGORIES = NUM_CATEGORY_MASKS - 1;
+
+//	Rerolls allowed each turn after the first roll.
+const unsigned int NUM_REROLLS = 2;
+
+//	Number of distinct sets of dice that can be held for a reroll: multisets of 0 to NUM_DICE values, which is the number
+//	of kinds of roll of NUM_DICE dice with one more face standing for "rerolled".
+const unsigned int NUM_KEEP_KINDS = 462;
+static_assert(CountRollKinds(NUM_DICE, MAX_DIE_VALUE + 1) == NUM_KEEP_KINDS, "NUM_KEEP_KINDS must count every keep");
+
+//	Which dice of a roll to hold for the next reroll.
+typedef std::array<bool, NUM_DICE> KeptDice;
+
+//	The solved game.  values[used] is the expected score of the rest of the game, played optimally, at the start of a turn
+//	with the used categories already scored.  The score so far doesn't matter to the rest of the game, since no category's
+//	score depends on another's.
+struct StrategyTable
+{
+	std::vector<double> values;
+};
+
+//	One outcome of rerolling everything but a kept set: the kind of roll it ends at, and its probability.
+struct Transition
+{
+	uint8_t roll;
+	double probability;
+};
+
+//	Everything about the dice that doesn't depend on the game state, built once and shared by every turn.
+//		Kinds of roll are indexed by GetRollIndex(); keeps in the order they're built.
+struct TransitionTable
+{
+	TransitionTable();
+
+	//	The outcomes of rerolling around keep k are outcomes[outcomeStarts[k]], ..., outcomes[outcomeStarts[k + 1] - 1].
+	std::vector<Transition> outcomes;
+	std::array<uint16_t, NUM_KEEP_KINDS + 1> outcomeStarts;
+
+	//	The keeps that roll r can hold are keeps[keepStarts[r]], ..., keeps[keepStarts[r + 1] - 1], each once.
+	std::vector<uint16_t> keeps;
+	std::array<uint16_t, NUM_ROLL_KINDS + 1> keepStarts;
+
+	//	The dice each keep holds, the keep holding all of each roll, and the keep holding none.
+	std::array<RollMap, NUM_KEEP_KINDS> keepMaps;
+	std::array<uint16_t, NUM_ROLL_KINDS> wholeKeeps;
+	uint16_t emptyKeep;
+};
+
+//	Expected scores of the rest of the game from every point within one turn.
+//		rolls[s][r] is for holding roll r with s rerolls left; keeps[s][k] is for rerolling around keep k with s rerolls
+//		left after it.
+struct TurnValues
+{
+	std::array<std::array<double, NUM_ROLL_KINDS>, NUM_REROLLS + 1> rolls;
+	std::array<std::array<double, NUM_KEEP_KINDS>, NUM_REROLLS> keeps;
+};
+
+//	Interface functions
+//		Solve the game by backward induction over the used categories: a turn's values depend only on the values of the
+//		states one more category along, so each layer of states with the same number of categories used is solved in
+//		parallel from the layer after it.  numThreads is the number of threads to use, or 0 to use one per hardware thread.
+void SolveStrategy(unsigned int numThreads, StrategyTable& strategy);
+//		The solved game, solved on first use with one thread per hardware thread.
+const StrategyTable& GetStrategy();
+//		Expected score of the rest of the game, played optimally, holding roll with rerollsLeft rerolls left this turn.
+double GetExpectedScore(CategoryMask used, const Roll& roll, unsigned int rerollsLeft);
+//		The category to score roll in when done rolling, or MAXVALUE if every category has been used.
+Category GetOptimalCategory(CategoryMask used, const Roll& roll);
+//		The dice to hold for the next reroll; all of them if there are no rerolls left, or rolling again can't do better.
+KeptDice GetOptimalKeep(CategoryMask used, const Roll& roll, unsigned int rerollsLeft);
+//		NOTE: roll must be valid, and rerollsLeft no more than NUM_REROLLS.
+
+//	Helper functions
+const TransitionTable& GetTransitions();
+void RunLayerWorker(std::atomic<size_t>* next, const std::vector<CategoryMask>* masks, StrategyTable* strategy);
+void SolveTurn(CategoryMask used, const StrategyTable& strategy, unsigned int rerollsLeft, TurnValues& turn);
+double ExpectKeep(const TransitionTable& transitions, unsigned int keep, const std::array<double, NUM_ROLL_KINDS>& rolls);
+unsigned int GetRollKind(const Roll& roll);
+
+#endif	//	STRATEGY_H
\ No newline at end of file
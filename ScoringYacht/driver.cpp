@@ -20,10 +20,14 @@
 
 #include <iostream>
 #include <array>
+#include <vector>
 #include "Constants.h"
 #include "Scoring.h"
+#include "BatchScoring.h"
+#include "Strategy.h"
 
 void RunTest(const Roll& roll);
+void RunBatchTest();
 
 int main()
 {
@@ -63,6 +67,10 @@ int main()
 	roll = { 2, 3, 4, 5, 6 };	//	big straight
 	RunTest(roll);
 
+	RunBatchTest();
+
+	std::cout << "Expected score of a game played optimally: " << GetStrategy().values[0] << std::endl;
+
 	return 0;
 }
 
@@ -93,5 +101,54 @@ void RunTest(const Roll& roll)
 	std::cout << "Yacht: " << GetScore(Yacht, roll) << std::endl;
 
 	std::cout << "Suggested Category is " << GetSuggestion(roll) << std::endl;
+	std::cout << "Suggested Category with Yacht and Choice used is " << GetSuggestion((1 << Yacht) | (1 << Choice), roll) << std::endl;
 	std::cout << "----------------------------------------------------------------\n";
+}
+
+//	Score every possible roll through the batch interface, and check it against GetScore().
+void RunBatchTest()
+{
+	//	Each roll is a base-6 number, one digit per die.
+	const unsigned int NUM_ROLLS = MAX_DIE_VALUE * MAX_DIE_VALUE * MAX_DIE_VALUE * MAX_DIE_VALUE * MAX_DIE_VALUE;
+	std::array<std::vector<uint8_t>, NUM_DICE> dice;
+	for (unsigned int code = 0; code < NUM_ROLLS; ++code)
+	{
+		unsigned int rest = code;
+		for (unsigned int i = 0; i < NUM_DICE; ++i)
+		{
+			dice[i].push_back(static_cast<uint8_t>(rest % MAX_DIE_VALUE + 1));
+			rest /= MAX_DIE_VALUE;
+		}
+	}
+
+	RollColumns rolls;
+	rolls.count = dice[0].size();
+	for (unsigned int i = 0; i < NUM_DICE; ++i)
+	{
+		rolls.dice[i] = dice[i].data();
+	}
+
+	std::array<std::vector<uint8_t>, NUM_CATEGORIES> scores;
+	ScoreColumns columns;
+	for (unsigned int category = Category::Ones; category < Category::MAXVALUE; ++category)
+	{
+		scores[category].resize(rolls.count);
+		columns[category] = scores[category].data();
+	}
+	GetAllScores(rolls, columns);
+
+	unsigned int mismatches = 0;
+	for (size_t r = 0; r < rolls.count; ++r)
+	{
+		Roll roll = { dice[0][r], dice[1][r], dice[2][r], dice[3][r], dice[4][r] };
+		for (unsigned int category = Category::Ones; category < Category::MAXVALUE; ++category)
+		{
+			if (scores[category][r] != GetScore(static_cast<Category>(category), roll))
+			{
+				++mismatches;
+			}
+		}
+	}
+
+	std::cout << "Batch scoring of " << rolls.count << " rolls: " << mismatches << " mismatches" << std::endl;
 }
\ No newline at end of file
@@ -0,0 +1,468 @@
+#include <atomic>		//	for atomic
+#include <cstdint>		//	for uint32_t, uint64_t
+#include <cstdio>		//	for fopen, fwrite
+#include <cstring>		//	for memchr, memcpy, memset
+#include <algorithm>	//	for count, min
+#include <thread>		//	for thread
+#include <vector>		//	for vector
+#include "Constants.h"
+#include "Solver.h"
+#include "MappedFile.h"
+#include "Lockstep.h"
+#include "PuzzleCache.h"
+#include "Batch.h"
+
+using namespace std;
+
+//	Number of bytes per output line, including the line break.
+template <unsigned int BASE>
+constexpr size_t OUTPUT_LINE_BYTES = PUZZLE_CHARS<BASE> + 1;
+
+//-------------------------------------------------------------
+//	A run of whole input lines, and the index of its first puzzle so results can be written in input order.
+struct BatchChunk
+{
+	size_t begin;
+	size_t end;
+	size_t firstPuzzle;
+};
+
+//	StealableRange class holds the chunk indices owned by one worker.
+//		The owner takes chunks from the front; idle workers steal the back half.  Both ends live in one atomic word, so neither side needs a lock.
+class StealableRange
+{
+	public:
+		StealableRange() : _range(0) {};
+
+		//	Replace the range with [begin, end).
+		//	NOTE: only safe while the range is empty or no other worker is running.
+		void Reset(uint32_t begin, uint32_t end) { _range.store(Pack(begin, end)); };
+
+		//	Take the next index from the front.  Returns false if the range is empty.
+		bool Take(size_t& index);
+		//	Steal the back half of this range into thief, taking its first index.  Returns false if the range is empty.
+		bool StealInto(StealableRange* thief, size_t& index);
+
+	private:
+		static uint64_t Pack(uint32_t begin, uint32_t end) { return (static_cast<uint64_t>(end) << 32) | begin; };
+		static uint32_t GetBegin(uint64_t range) { return static_cast<uint32_t>(range); };
+		static uint32_t GetEnd(uint64_t range) { return static_cast<uint32_t>(range >> 32); };
+
+		atomic<uint64_t> _range;
+};
+
+bool StealableRange::Take(size_t& index)
+{
+	uint64_t range = _range.load();
+	while (GetBegin(range) < GetEnd(range))
+	{
+		if (_range.compare_exchange_weak(range, Pack(GetBegin(range) + 1, GetEnd(range))))
+		{
+			index = GetBegin(range);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool StealableRange::StealInto(StealableRange* thief, size_t& index)
+{
+	uint64_t range = _range.load();
+	while (GetBegin(range) < GetEnd(range))
+	{
+		//	Round up, so a single remaining chunk can still be stolen.
+		uint32_t stolen = (GetEnd(range) - GetBegin(range) + 1) / 2;
+		uint32_t split = GetEnd(range) - stolen;
+
+		if (_range.compare_exchange_weak(range, Pack(GetBegin(range), split)))
+		{
+			index = split;
+			thief->Reset(split + 1, GetEnd(range));
+			return true;
+		}
+	}
+
+	return false;
+}
+//-------------------------------------------------------------
+
+void SplitIntoChunks(const char* data, size_t size, vector<BatchChunk>& chunks, size_t& numPuzzles);
+unsigned int DetectBase(const char* data, size_t size);
+template <unsigned int BASE>
+bool SolveBatchOfBase(const MappedFile& input, const char* outputPath, const BatchOptions& options, BatchSummary& summary);
+template <unsigned int BASE>
+void SolveChunk(const char* data, const BatchChunk& chunk, const BatchOptions& options, PuzzleCache& cache, char* output, BatchSummary& summary);
+template <unsigned int BASE>
+void SolveGroup(Grid<BASE>* grids, char* const* slots, size_t count, const BatchOptions& options, PuzzleCache& cache, BatchSummary& summary);
+void SolveGroup(Grid<3>* grids, char* const* slots, size_t count, const BatchOptions& options, PuzzleCache& cache, BatchSummary& summary);
+template <unsigned int BASE>
+void RecordResult(const Grid<BASE>& grid, SolveResult result, char* slot, BatchSummary& summary);
+SearchLimits GetPuzzleLimits(const BatchOptions& options);
+template <unsigned int BASE>
+void RunWorker(unsigned int workerID, vector<StealableRange>* ranges, const char* data, const vector<BatchChunk>* chunks, const BatchOptions* options, PuzzleCache* cache, char* output, BatchSummary* summary);
+
+bool SolveBatch(const char* inputPath, const char* outputPath, const BatchOptions& options, BatchSummary& summary)
+{
+	summary.solved = 0;
+	summary.unsolvable = 0;
+	summary.budgetExhausted = 0;
+
+	MappedFile input;
+	if (!input.Open(inputPath))
+	{
+		return false;
+	}
+
+	//	Every puzzle in a file is expected to be the same size as the first one; lines of any other length are unsolvable.
+	switch (DetectBase(input.GetData(), input.GetSize()))
+	{
+		case 4:		return SolveBatchOfBase<4>(input, outputPath, options, summary);
+		case 5:		return SolveBatchOfBase<5>(input, outputPath, options, summary);
+		default:	return SolveBatchOfBase<3>(input, outputPath, options, summary);
+	}
+}
+
+//	Returns the base of the first line that has the length of a supported puzzle size, or MIN_BASE if there isn't one.
+unsigned int DetectBase(const char* data, size_t size)
+{
+	size_t begin = 0;
+	while (begin < size)
+	{
+		const char* lineBreak = static_cast<const char*>(memchr(data + begin, '\n', size - begin));
+		size_t end = (lineBreak != nullptr) ? static_cast<size_t>(lineBreak - data) : size;
+
+		size_t length = end - begin;
+		if (length > 0 && data[end - 1] == '\r')
+		{
+			--length;
+		}
+
+		unsigned int base = GetBaseForPuzzleLength(length);
+		if (base != 0)
+		{
+			return base;
+		}
+
+		begin = end + 1;
+	}
+
+	return MIN_BASE;
+}
+
+//	Returns the base whose puzzles are length characters long, or 0 if no supported size matches.
+unsigned int GetBaseForPuzzleLength(size_t length)
+{
+	switch (length)
+	{
+		case PUZZLE_CHARS<3>:	return 3;
+		case PUZZLE_CHARS<4>:	return 4;
+		case PUZZLE_CHARS<5>:	return 5;
+		default:				return 0;
+	}
+}
+
+//	Solves every puzzle in input as a BASE puzzle.
+template <unsigned int BASE>
+bool SolveBatchOfBase(const MappedFile& input, const char* outputPath, const BatchOptions& options, BatchSummary& summary)
+{
+	vector<BatchChunk> chunks;
+	size_t numPuzzles;
+	SplitIntoChunks(input.GetData(), input.GetSize(), chunks, numPuzzles);
+
+	//	Every puzzle has a fixed-size slot, so workers can write results in input order without coordinating.
+	vector<char> output(numPuzzles * OUTPUT_LINE_BYTES<BASE>);
+
+	unsigned int numThreads = options.numThreads;
+	if (numThreads == 0)
+	{
+		numThreads = max(thread::hardware_concurrency(), 1u);
+	}
+	numThreads = static_cast<unsigned int>(min<size_t>(numThreads, max<size_t>(chunks.size(), 1)));
+
+	//	Deal the chunks out in contiguous ranges; workers that finish early steal from the others.
+	vector<StealableRange> ranges(numThreads);
+	for (unsigned int workerID = 0; workerID < numThreads; ++workerID)
+	{
+		ranges[workerID].Reset(static_cast<uint32_t>(chunks.size() * workerID / numThreads),
+								static_cast<uint32_t>(chunks.size() * (workerID + 1) / numThreads));
+	}
+
+	//	Only 9x9 puzzles have a canonical form, so the cache is left disabled for larger boards.
+	PuzzleCache cache((BASE == 3) ? options.cacheEntries : 0);
+
+	vector<BatchSummary> workerSummaries(numThreads, summary);
+	vector<thread> workers;
+	for (unsigned int workerID = 0; workerID < numThreads; ++workerID)
+	{
+		workers.push_back(thread(RunWorker<BASE>, workerID, &ranges, input.GetData(), &chunks, &options, &cache, output.data(), &workerSummaries[workerID]));
+	}
+	for (unsigned int workerID = 0; workerID < numThreads; ++workerID)
+	{
+		workers[workerID].join();
+
+		summary.solved += workerSummaries[workerID].solved;
+		summary.unsolvable += workerSummaries[workerID].unsolvable;
+		summary.budgetExhausted += workerSummaries[workerID].budgetExhausted;
+	}
+
+	//	Write every result with one bulk write.
+	bool toStdout = (outputPath == nullptr || strcmp(outputPath, "-") == 0);
+	FILE* file = toStdout ? stdout : fopen(outputPath, "wb");
+	if (file == nullptr)
+	{
+		return false;
+	}
+
+	bool written = (fwrite(output.data(), 1, output.size(), file) == output.size());
+	written = (fflush(file) == 0) && written;
+	if (!toStdout)
+	{
+		written = (fclose(file) == 0) && written;
+	}
+
+	return written;
+}
+
+//	Splits the input into chunks of roughly BATCH_CHUNK_BYTES that end on line breaks, numbering the puzzles as it goes.
+void SplitIntoChunks(const char* data, size_t size, vector<BatchChunk>& chunks, size_t& numPuzzles)
+{
+	numPuzzles = 0;
+
+	size_t begin = 0;
+	while (begin < size)
+	{
+		//	Extend the chunk to just past the next line break, or to the end of the file.
+		size_t end = min(begin + BATCH_CHUNK_BYTES, size);
+		const char* lineBreak = static_cast<const char*>(memchr(data + end - 1, '\n', size - end + 1));
+		end = (lineBreak != nullptr) ? static_cast<size_t>(lineBreak - data) + 1 : size;
+
+		BatchChunk chunk = { begin, end, numPuzzles };
+		chunks.push_back(chunk);
+
+		//	Count the lines in this chunk; a final line without a line break still counts.
+		numPuzzles += count(data + begin, data + end, '\n');
+		if (data[end - 1] != '\n')
+		{
+			++numPuzzles;
+		}
+
+		begin = end;
+	}
+}
+
+//	Solves every puzzle in a chunk, writing each result to its slot in output.
+//		Well-formed puzzles are gathered into groups of LOCKSTEP_LANES, so 9x9 puzzles can be propagated side by side.
+template <unsigned int BASE>
+void SolveChunk(const char* data, const BatchChunk& chunk, const BatchOptions& options, PuzzleCache& cache, char* output, BatchSummary& summary)
+{
+	Grid<BASE> grids[LOCKSTEP_LANES];
+	char* slots[LOCKSTEP_LANES];
+	size_t count = 0;
+
+	char* slot = output + chunk.firstPuzzle * OUTPUT_LINE_BYTES<BASE>;
+
+	size_t begin = chunk.begin;
+	while (begin < chunk.end)
+	{
+		const char* lineBreak = static_cast<const char*>(memchr(data + begin, '\n', chunk.end - begin));
+		size_t end = (lineBreak != nullptr) ? static_cast<size_t>(lineBreak - data) : chunk.end;
+
+		//	Accept both LF and CRLF line endings.
+		size_t length = end - begin;
+		if (length > 0 && data[end - 1] == '\r')
+		{
+			--length;
+		}
+
+		if (ParsePuzzle(data + begin, length, grids[count]))
+		{
+			slots[count++] = slot;
+			if (count == LOCKSTEP_LANES)
+			{
+				SolveGroup(grids, slots, count, options, cache, summary);
+				count = 0;
+			}
+		}
+		else
+		{
+			//	Write the line back as given, cut or padded with '.' to the puzzle length so it keeps its fixed-width slot.
+			summary.unsolvable++;
+			size_t copied = min(length, PUZZLE_CHARS<BASE>);
+			memcpy(slot, data + begin, copied);
+			memset(slot + copied, '.', PUZZLE_CHARS<BASE> - copied);
+			slot[PUZZLE_CHARS<BASE>] = '\n';
+		}
+
+		slot += OUTPUT_LINE_BYTES<BASE>;
+		begin = end + 1;
+	}
+
+	SolveGroup(grids, slots, count, options, cache, summary);
+}
+
+//	Solves a group of puzzles one at a time.
+//	NOTE: the cache only holds 9x9 puzzles, so it's unused here.
+template <unsigned int BASE>
+void SolveGroup(Grid<BASE>* grids, char* const* slots, size_t count, const BatchOptions& options, PuzzleCache&, BatchSummary& summary)
+{
+	for (size_t i = 0; i < count; ++i)
+	{
+		SolveResult result = SolveSudoku(grids[i], GetPuzzleLimits(options), options.backend);
+		RecordResult(grids[i], result, slots[i], summary);
+	}
+}
+
+//	Solves a group of 9x9 puzzles, propagating them side by side first and only searching those that need a guess.
+//		Only the searched puzzles go through the cache; propagation is cheaper than canonicalizing.
+void SolveGroup(Grid<3>* grids, char* const* slots, size_t count, const BatchOptions& options, PuzzleCache& cache, BatchSummary& summary)
+{
+	LockstepResult propagated[LOCKSTEP_LANES];
+	if (options.backend == CandidateSearch)
+	{
+		SolveLockstep(grids, count, propagated);
+	}
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		SolveResult result;
+		if (options.backend != CandidateSearch || propagated[i] == NeedsSearch)
+		{
+			result = SolveSudoku(grids[i], GetPuzzleLimits(options), options.backend, cache);
+		}
+		else
+		{
+			result = (propagated[i] == SolvedByPropagation) ? Solved : Unsolvable;
+		}
+		RecordResult(grids[i], result, slots[i], summary);
+	}
+}
+
+//	Counts a puzzle's result and writes its line.
+//	NOTE: unsolved puzzles are left as given, so the grid holds either the solution or the puzzle.
+template <unsigned int BASE>
+void RecordResult(const Grid<BASE>& grid, SolveResult result, char* slot, BatchSummary& summary)
+{
+	switch (result)
+	{
+		case Solved:			summary.solved++;			break;
+		case Unsolvable:		summary.unsolvable++;		break;
+		case BudgetExhausted:	summary.budgetExhausted++;	break;
+	}
+
+	FormatGrid(grid, slot);
+	slot[PUZZLE_CHARS<BASE>] = '\n';
+}
+
+//	Returns the limits for one puzzle, with its deadline starting now.
+SearchLimits GetPuzzleLimits(const BatchOptions& options)
+{
+	SearchLimits limits;
+	limits.maxNodes = options.maxNodesPerPuzzle;
+	if (options.timePerPuzzle.count() > 0)
+	{
+		limits.deadline = chrono::steady_clock::now() + options.timePerPuzzle;
+	}
+
+	return limits;
+}
+
+//	Solves chunks from this worker's own range, then steals from the others until no work is left anywhere.
+template <unsigned int BASE>
+void RunWorker(unsigned int workerID, vector<StealableRange>* ranges, const char* data, const vector<BatchChunk>* chunks, const BatchOptions* options, PuzzleCache* cache, char* output, BatchSummary* summary)
+{
+	unsigned int numWorkers = static_cast<unsigned int>(ranges->size());
+	StealableRange* own = &(*ranges)[workerID];
+
+	size_t chunkID;
+	for (;;)
+	{
+		bool found = own->Take(chunkID);
+		for (unsigned int offset = 1; offset < numWorkers && !found; ++offset)
+		{
+			found = (*ranges)[(workerID + offset) % numWorkers].StealInto(own, chunkID);
+		}
+
+		//	Chunks are never added after the start, so if every range is empty the batch is done.
+		if (!found)
+		{
+			return;
+		}
+
+		SolveChunk<BASE>(data, (*chunks)[chunkID], *options, *cache, output, *summary);
+	}
+}
+
+//	Reads one puzzle line into grid.
+//	Returns false if the line has the wrong length or an unexpected character.  Unexpected characters are read as empty cells.
+template <unsigned int BASE>
+bool ParsePuzzle(const char* text, size_t length, Grid<BASE>& grid)
+{
+	bool valid = (length == PUZZLE_CHARS<BASE>);
+
+	for (size_t cell = 0; cell < PUZZLE_CHARS<BASE>; ++cell)
+	{
+		char c = (cell < length) ? text[cell] : '.';
+		unsigned int value = 0;
+
+		if (c >= '1' && c <= '9')
+		{
+			value = c - '0';
+		}
+		else if (c >= 'A' && c <= 'Z')
+		{
+			value = c - 'A' + 10;
+		}
+		else if (c >= 'a' && c <= 'z')
+		{
+			value = c - 'a' + 10;
+		}
+		else if (c != '.' && c != '0')
+		{
+			valid = false;
+		}
+
+		if (value > MAX_VALUE<BASE>)
+		{
+			value = 0;
+			valid = false;
+		}
+
+		//  NOTE: Intentional integer division
+		grid[static_cast<unsigned int>(cell / LENGTH<BASE>)][cell % LENGTH<BASE>] = value;
+	}
+
+	return valid;
+}
+
+//	Writes grid as PUZZLE_CHARS characters, with '.' for empty cells.
+template <unsigned int BASE>
+void FormatGrid(const Grid<BASE>& grid, char* text)
+{
+	for (unsigned int y = 0; y < LENGTH<BASE>; ++y)
+	{
+		for (unsigned int x = 0; x < LENGTH<BASE>; ++x)
+		{
+			*text++ = FormatValue(grid[y][x]);
+		}
+	}
+}
+
+//	Returns the character for a cell value: '.' for empty, '1' - '9', then 'A' onwards for 10 and up.
+char FormatValue(unsigned int value)
+{
+	if (value == 0)
+	{
+		return '.';
+	}
+
+	return (value <= 9) ? static_cast<char>('0' + value) : static_cast<char>('A' + value - 10);
+}
+
+//	Every supported board size is instantiated here, so callers only need the declarations in Batch.h.
+template bool ParsePuzzle<3>(const char* text, size_t length, Grid<3>& grid);
+template bool ParsePuzzle<4>(const char* text, size_t length, Grid<4>& grid);
+template bool ParsePuzzle<5>(const char* text, size_t length, Grid<5>& grid);
+template void FormatGrid<3>(const Grid<3>& grid, char* text);
+template void FormatGrid<4>(const Grid<4>& grid, char* text);
+template void FormatGrid<5>(const Grid<5>& grid, char* text);
\ No newline at end of file
@@ -0,0 +1,56 @@
+#ifndef BATCH_H
+#define BATCH_H
+#pragma once
+
+#include <cstddef>	//	for size_t
+#include <chrono>	//	for microseconds
+#include "Constants.h"
+#include "Solver.h"
+
+//	Number of characters in one puzzle line, excluding the line break.
+template <unsigned int BASE>
+constexpr size_t PUZZLE_CHARS = LENGTH<BASE> * LENGTH<BASE>;
+
+//	Number of input bytes handed out per work item.  Chunks are extended to the next line break, so each holds only whole puzzles.
+const size_t BATCH_CHUNK_BYTES = 16 * 1024;
+
+//	Settings for a batch run.
+struct BatchOptions
+{
+	//	Create options that use every core and never stop a search early.
+	BatchOptions() : numThreads(0), maxNodesPerPuzzle(0), timePerPuzzle(0), backend(CandidateSearch), cacheEntries(0) {};
+
+	unsigned int numThreads;					//	Number of worker threads, or 0 to use one per hardware thread.
+	unsigned long long maxNodesPerPuzzle;		//	Maximum number of guesses per puzzle, or 0 for no limit.
+	std::chrono::microseconds timePerPuzzle;	//	Wall-clock budget per puzzle, or 0 for no limit.
+	SolverBackend backend;						//	Search algorithm used for every puzzle.
+	size_t cacheEntries;						//	Number of 9x9 results kept for reuse by equivalent puzzles (see PuzzleCache), or 0 for none.
+};
+
+//	Counts of each outcome in a batch run.
+struct BatchSummary
+{
+	size_t solved;
+	size_t unsolvable;			//	Includes lines that aren't well-formed puzzles.
+	size_t budgetExhausted;
+};
+
+//	Interface functions
+//		Each line of the input file holds one puzzle of PUZZLE_CHARS characters, '1' - '9' then 'A' onwards for givens and '.' or '0' for empty cells.
+//		The board size (9x9, 16x16, or 25x25) is taken from the length of the first puzzle line.
+//		The output file holds one line per input line, in input order: the solution if one was found, otherwise the puzzle as given.
+//		A line that isn't a well-formed puzzle is also written as given, cut or padded with '.' to the first line's length.
+//		If outputPath is nullptr or "-", output goes to stdout.
+bool SolveBatch(const char* inputPath, const char* outputPath, const BatchOptions& options, BatchSummary& summary);
+//		GetBaseForPuzzleLength() maps a puzzle line's length to its BASE, or 0 if it isn't a supported size.
+unsigned int GetBaseForPuzzleLength(size_t length);
+
+//	Helper functions
+//		ParsePuzzle() and FormatGrid() are instantiated for every BASE from MIN_BASE to MAX_BASE in Batch.cpp.
+template <unsigned int BASE>
+bool ParsePuzzle(const char* text, size_t length, Grid<BASE>& grid);
+template <unsigned int BASE>
+void FormatGrid(const Grid<BASE>& grid, char* text);
+char FormatValue(unsigned int value);
+
+#endif	//	BATCH_H
\ No newline at end of file
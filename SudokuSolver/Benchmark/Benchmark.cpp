@@ -0,0 +1,188 @@
+/*
+	PROBLEM: Measure how fast the solver works through known sets of puzzles, and how much searching it does.
+
+	USAGE:	Benchmark [-d] [-r repeats] [corpus ...]
+										Solves every puzzle in each corpus one at a time on a single thread, and reports puzzles per
+										second, median and 99th percentile latency, and the nodes, backtracks, and propagation steps
+										per puzzle.  The corpora default to the four in Corpora/, read from the current directory.
+										-d uses the Dancing Links exact-cover solver instead of candidate search.
+										-r solves each corpus repeats times, for steadier percentiles on small corpora.
+
+	BUILD:	The search counters are only kept when SEARCH_STATS is defined; without it they report as zero and cost nothing.
+			g++ -std=c++17 -O2 -pthread -DSEARCH_STATS Benchmark.cpp ../Batch.cpp ../MappedFile.cpp ../Lockstep.cpp ../Canonical.cpp ../PuzzleCache.cpp
+*/
+
+#include <iostream>		//	for cout
+#include <iomanip>		//	for setw, setprecision
+#include <fstream>		//	for ifstream
+#include <string>		//	for string, getline
+#include <vector>		//	for vector
+#include <algorithm>	//	for min, sort
+#include <chrono>		//	for steady_clock
+#include <cstring>		//	for strcmp
+#include <cstdlib>		//	for strtoul
+#include "../Constants.h"
+#include "../Solver.h"
+#include "../SearchStats.h"
+#include "../Batch.h"
+
+using namespace std;
+
+//	Corpora solved when none are named on the command line.
+const char* const DEFAULT_CORPORA[] = { "Corpora/easy.txt", "Corpora/hard.txt", "Corpora/17-clue.txt", "Corpora/16x16.txt" };
+
+//	Measurements for one corpus.
+struct CorpusResults
+{
+	vector<double> latencies;		//	Microseconds per puzzle.
+	SearchStats totals;
+	size_t solved;
+};
+
+bool RunCorpus(const char* path, unsigned int repeats, SolverBackend backend, CorpusResults& results);
+template <unsigned int BASE>
+void TimePuzzle(const string& line, SolverBackend backend, CorpusResults& results);
+void OutputCorpus(const char* path, CorpusResults& results);
+
+int main(int argc, char* argv[]) {
+
+	SolverBackend backend = CandidateSearch;
+	unsigned int repeats = 1;
+
+	int arg = 1;
+	for (; arg < argc && argv[arg][0] == '-'; ++arg)
+	{
+		if (strcmp(argv[arg], "-d") == 0)
+		{
+			backend = DancingLinksSearch;
+		}
+		else if (strcmp(argv[arg], "-r") == 0 && arg + 1 < argc)
+		{
+			repeats = max(static_cast<unsigned int>(strtoul(argv[++arg], nullptr, 10)), 1u);
+		}
+		else
+		{
+			cerr << "Usage: Benchmark [-d] [-r repeats] [corpus ...]\n";
+			return 1;
+		}
+	}
+
+	vector<const char*> corpora(argv + arg, argv + argc);
+	if (corpora.empty())
+	{
+		for (const char* corpus : DEFAULT_CORPORA)
+		{
+			corpora.push_back(corpus);
+		}
+	}
+
+#if !defined(SEARCH_STATS)
+	cout << "NOTE: built without SEARCH_STATS, so nodes, backtracks, and propagation steps are not counted.\n";
+#endif
+	cout << left << setw(24) << "Corpus" << right << setw(8) << "Puzzles" << setw(8) << "Solved" << setw(12) << "Puzzles/s"
+		 << setw(10) << "p50 us" << setw(10) << "p99 us" << setw(12) << "Nodes" << setw(12) << "Backtracks" << setw(12) << "Prop steps" << "\n";
+
+	for (const char* path : corpora)
+	{
+		CorpusResults results;
+		if (!RunCorpus(path, repeats, backend, results))
+		{
+			cerr << "Unable to read " << path << ".\n";
+			return 1;
+		}
+
+		OutputCorpus(path, results);
+	}
+
+	return 0;
+}
+
+//	Solves every puzzle in the corpus repeats times, recording each one's latency and search counters.
+//	Returns false if the corpus can't be read.  Lines that aren't puzzles of a supported size are skipped.
+bool RunCorpus(const char* path, unsigned int repeats, SolverBackend backend, CorpusResults& results)
+{
+	ifstream input(path);
+	if (!input)
+	{
+		return false;
+	}
+
+	vector<string> lines;
+	string line;
+	while (getline(input, line))
+	{
+		//	Accept both LF and CRLF line endings.
+		if (!line.empty() && line.back() == '\r')
+		{
+			line.pop_back();
+		}
+		lines.push_back(line);
+	}
+
+	results.totals = SearchStats();
+	results.solved = 0;
+
+	for (unsigned int pass = 0; pass < repeats; ++pass)
+	{
+		for (const string& puzzle : lines)
+		{
+			switch (GetBaseForPuzzleLength(puzzle.size()))
+			{
+				case 3:		TimePuzzle<3>(puzzle, backend, results);	break;
+				case 4:		TimePuzzle<4>(puzzle, backend, results);	break;
+				case 5:		TimePuzzle<5>(puzzle, backend, results);	break;
+				default:	break;
+			}
+		}
+	}
+
+	return true;
+}
+
+//	Solves one puzzle line of the given BASE, adding its latency and search counters to results.
+template <unsigned int BASE>
+void TimePuzzle(const string& line, SolverBackend backend, CorpusResults& results)
+{
+	Grid<BASE> grid;
+	if (!ParsePuzzle(line.c_str(), line.size(), grid))
+	{
+		return;
+	}
+
+	ResetSearchStats();
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	SolveResult result = SolveSudoku(grid, SearchLimits(), backend);
+	chrono::steady_clock::time_point finish = chrono::steady_clock::now();
+
+	results.latencies.push_back(chrono::duration<double, micro>(finish - start).count());
+	if (result == Solved)
+	{
+		results.solved++;
+	}
+
+	SearchStats stats = GetSearchStats();
+	results.totals.nodes += stats.nodes;
+	results.totals.backtracks += stats.backtracks;
+	results.totals.propagations += stats.propagations;
+}
+
+//	Writes one row of the report.  Counters are averaged per puzzle.
+void OutputCorpus(const char* path, CorpusResults& results)
+{
+	size_t count = results.latencies.size();
+	double total = 0;
+	for (double latency : results.latencies)
+	{
+		total += latency;
+	}
+
+	sort(results.latencies.begin(), results.latencies.end());
+	double p50 = (count > 0) ? results.latencies[count / 2] : 0;
+	double p99 = (count > 0) ? results.latencies[min(count - 1, count * 99 / 100)] : 0;
+
+	double perPuzzle = (count > 0) ? 1.0 / count : 0;
+	cout << left << setw(24) << path << right << setw(8) << count << setw(8) << results.solved << fixed << setprecision(0)
+		 << setw(12) << ((total > 0) ? count * 1e6 / total : 0) << setprecision(1) << setw(10) << p50 << setw(10) << p99
+		 << setw(12) << results.totals.nodes * perPuzzle << setw(12) << results.totals.backtracks * perPuzzle
+		 << setw(12) << results.totals.propagations * perPuzzle << "\n";
+}
\ No newline at end of file
@@ -0,0 +1,357 @@
+#include <algorithm>	//	for copy, swap
+#include "Constants.h"
+#include "Solver.h"
+#include "Canonical.h"
+
+using namespace std;
+
+//	Number of cells in a 9x9 grid.
+const unsigned int NUM_CELLS = LENGTH<3> * LENGTH<3>;
+
+//	Every ordering of three rows, columns, bands, or stacks.
+const unsigned int NUM_PERMUTATIONS = 6;
+const unsigned int PERMUTATIONS[NUM_PERMUTATIONS][3] = {
+	{ 0, 1, 2 }, { 0, 2, 1 }, { 1, 0, 2 }, { 1, 2, 0 }, { 2, 0, 1 }, { 2, 1, 0 }
+};
+
+//-------------------------------------------------------------
+//	Best form found so far by Canonicalize(), and the transform that produced it.
+//		Arrangements are compared stack by stack: keys[0] holds the first stack's column patterns of every row, in sorted row order;
+//		keys[1] the first two stacks', and keys[2] the whole rows'.  Arrangements with equal keys are compared by value.
+struct CanonicalSearch
+{
+	bool keyed;								//	True once keys holds a complete arrangement.
+	bool found;								//	True once values and transform hold an arrangement with those keys.
+	unsigned int keys[3][LENGTH<3>];
+	unsigned int values[NUM_CELLS];
+	SymmetryTransform transform;
+};
+
+void SearchStacks(const Grid<3>& source, bool transpose, const unsigned int chunks[LENGTH<3>][3], unsigned int level, unsigned int usedStacks, const unsigned int* prefixes, unsigned int* colMap, CanonicalSearch& best);
+void SearchRowArrangements(const Grid<3>& source, bool transpose, const unsigned int* colMap, const unsigned int* patterns, CanonicalSearch& best);
+void TryArrangement(const Grid<3>& source, bool transpose, const unsigned int* rowMap, const unsigned int* colMap, CanonicalSearch& best);
+void GetSortedKey(const unsigned int* patterns, unsigned int* key);
+void GetSortedRowOrders(const unsigned int* rows, const unsigned int* patterns, unsigned int orders[NUM_PERMUTATIONS][3], unsigned int& numOrders);
+int CompareKeys(const unsigned int* a, const unsigned int* b);
+int CompareBands(const unsigned int* a, const unsigned int* b);
+//-------------------------------------------------------------
+
+void Canonicalize(const Grid<3>& grid, Grid<3>& canonical, SymmetryTransform& transform)
+{
+	CanonicalSearch best;
+	best.keyed = false;
+	best.found = false;
+
+	for (unsigned int t = 0; t < 2; ++t)
+	{
+		Grid<3> source;
+		for (unsigned int y = 0; y < LENGTH<3>; ++y)
+		{
+			for (unsigned int x = 0; x < LENGTH<3>; ++x)
+			{
+				source[y][x] = (t == 0) ? grid[y][x] : grid[x][y];
+			}
+		}
+
+		//	Givens in each row's stacks, as three bits with the stack's first column highest.
+		unsigned int chunks[LENGTH<3>][3];
+		for (unsigned int y = 0; y < LENGTH<3>; ++y)
+		{
+			for (unsigned int stack = 0; stack < 3; ++stack)
+			{
+				chunks[y][stack] = 0;
+				for (unsigned int i = 0; i < 3; ++i)
+				{
+					chunks[y][stack] = (chunks[y][stack] << 1) | ((source[y][stack * 3 + i] != 0) ? 1 : 0);
+				}
+			}
+		}
+
+		unsigned int prefixes[LENGTH<3>] = {};
+		unsigned int colMap[LENGTH<3>];
+		SearchStacks(source, t != 0, chunks, 0, 0, prefixes, colMap, best);
+	}
+
+	transform = best.transform;
+	for (unsigned int cell = 0; cell < NUM_CELLS; ++cell)
+	{
+		//  NOTE: Intentional integer division
+		canonical[cell / LENGTH<3>][cell % LENGTH<3>] = best.values[cell];
+	}
+}
+
+//	Chooses the source stack and column order for target stack level, pruning any choice whose key is already larger than the best.
+void SearchStacks(const Grid<3>& source, bool transpose, const unsigned int chunks[LENGTH<3>][3], unsigned int level, unsigned int usedStacks, const unsigned int* prefixes, unsigned int* colMap, CanonicalSearch& best)
+{
+	unsigned int patterns[LENGTH<3>];
+	unsigned int key[LENGTH<3>];
+
+	for (unsigned int stack = 0; stack < 3; ++stack)
+	{
+		if ((usedStacks & (1u << stack)) != 0)
+		{
+			continue;
+		}
+
+		for (unsigned int order = 0; order < NUM_PERMUTATIONS; ++order)
+		{
+			//	Extend every row's pattern with this stack's columns, in this order.
+			for (unsigned int y = 0; y < LENGTH<3>; ++y)
+			{
+				unsigned int chunk = 0;
+				for (unsigned int i = 0; i < 3; ++i)
+				{
+					chunk = (chunk << 1) | ((chunks[y][stack] >> (2 - PERMUTATIONS[order][i])) & 1);
+				}
+				patterns[y] = (prefixes[y] << 3) | chunk;
+			}
+
+			GetSortedKey(patterns, key);
+			int comparison = best.keyed ? CompareKeys(key, best.keys[level]) : -1;
+			if (comparison > 0)
+			{
+				continue;
+			}
+
+			//	A smaller key beats every arrangement found so far, whatever the remaining stacks hold.
+			if (comparison < 0)
+			{
+				best.keyed = false;
+				best.found = false;
+			}
+
+			for (unsigned int i = 0; i < 3; ++i)
+			{
+				colMap[level * 3 + i] = stack * 3 + PERMUTATIONS[order][i];
+			}
+
+			if (level < 2)
+			{
+				SearchStacks(source, transpose, chunks, level + 1, usedStacks | (1u << stack), patterns, colMap, best);
+				continue;
+			}
+
+			//	The columns are complete.  Record the keys, then compare every row arrangement with them by value.
+			//	NOTE: the shorter keys sort the shortened patterns afresh; bands can order differently on them.
+			if (!best.keyed)
+			{
+				for (unsigned int shorter = 0; shorter < 2; ++shorter)
+				{
+					unsigned int prefixPatterns[LENGTH<3>];
+					for (unsigned int y = 0; y < LENGTH<3>; ++y)
+					{
+						prefixPatterns[y] = patterns[y] >> (3 * (2 - shorter));
+					}
+					GetSortedKey(prefixPatterns, best.keys[shorter]);
+				}
+				copy(key, key + LENGTH<3>, best.keys[2]);
+				best.keyed = true;
+			}
+
+			SearchRowArrangements(source, transpose, colMap, patterns, best);
+		}
+	}
+}
+
+//	Tries every row arrangement that sorts the rows within each band, and the bands, into ascending order.
+//		Only rows (or bands) with equal patterns have more than one order, so this is usually a single arrangement.
+void SearchRowArrangements(const Grid<3>& source, bool transpose, const unsigned int* colMap, const unsigned int* patterns, CanonicalSearch& best)
+{
+	unsigned int bandOrders[3][NUM_PERMUTATIONS][3];
+	unsigned int numBandOrders[3];
+	unsigned int bandPatterns[3][3];
+	for (unsigned int band = 0; band < 3; ++band)
+	{
+		unsigned int rows[3] = { band * 3, band * 3 + 1, band * 3 + 2 };
+		GetSortedRowOrders(rows, patterns, bandOrders[band], numBandOrders[band]);
+		for (unsigned int i = 0; i < 3; ++i)
+		{
+			bandPatterns[band][i] = patterns[bandOrders[band][0][i]];
+		}
+	}
+
+	unsigned int rowMap[LENGTH<3>];
+	for (unsigned int p = 0; p < NUM_PERMUTATIONS; ++p)
+	{
+		//	Skip band orders that aren't ascending.
+		const unsigned int* bands = PERMUTATIONS[p];
+		if (CompareBands(bandPatterns[bands[0]], bandPatterns[bands[1]]) > 0 || CompareBands(bandPatterns[bands[1]], bandPatterns[bands[2]]) > 0)
+		{
+			continue;
+		}
+
+		for (unsigned int i = 0; i < numBandOrders[bands[0]]; ++i)
+		{
+			for (unsigned int j = 0; j < numBandOrders[bands[1]]; ++j)
+			{
+				for (unsigned int k = 0; k < numBandOrders[bands[2]]; ++k)
+				{
+					for (unsigned int r = 0; r < 3; ++r)
+					{
+						rowMap[r] = bandOrders[bands[0]][i][r];
+						rowMap[3 + r] = bandOrders[bands[1]][j][r];
+						rowMap[6 + r] = bandOrders[bands[2]][k][r];
+					}
+					TryArrangement(source, transpose, rowMap, colMap, best);
+				}
+			}
+		}
+	}
+}
+
+//	Compares one arrangement's relabelled values against the best so far, and keeps it if they're smaller.
+//	NOTE: the arrangement's keys must equal the best's.
+void TryArrangement(const Grid<3>& source, bool transpose, const unsigned int* rowMap, const unsigned int* colMap, CanonicalSearch& best)
+{
+	//	Stays false until the arrangement is known to be smaller; returning early means it's larger.
+	bool smaller = !best.found;
+
+	unsigned int valueMap[MAX_VALUE<3> + 1] = {};
+	unsigned int nextValue = 1;
+	unsigned int values[NUM_CELLS];
+	for (unsigned int cell = 0; cell < NUM_CELLS; ++cell)
+	{
+		//  NOTE: Intentional integer division
+		unsigned int value = source[rowMap[cell / LENGTH<3>]][colMap[cell % LENGTH<3>]];
+		if (value != 0 && valueMap[value] == 0)
+		{
+			valueMap[value] = nextValue++;
+		}
+		values[cell] = valueMap[value];
+
+		if (!smaller && values[cell] != best.values[cell])
+		{
+			if (values[cell] > best.values[cell])
+			{
+				return;
+			}
+			smaller = true;
+		}
+	}
+
+	//	Identical forms are equally good; keep the first transform found.
+	if (!smaller)
+	{
+		return;
+	}
+
+	//	Values that don't appear take the remaining labels, so the transform is a complete relabelling.
+	for (unsigned int value = 1; value <= MAX_VALUE<3>; ++value)
+	{
+		if (valueMap[value] == 0)
+		{
+			valueMap[value] = nextValue++;
+		}
+	}
+
+	best.found = true;
+	copy(values, values + NUM_CELLS, best.values);
+
+	best.transform.transpose = transpose;
+	copy(rowMap, rowMap + LENGTH<3>, best.transform.rowMap);
+	copy(colMap, colMap + LENGTH<3>, best.transform.colMap);
+	copy(valueMap, valueMap + MAX_VALUE<3> + 1, best.transform.valueMap);
+}
+
+//	Writes the row patterns in the order they'd take with each band sorted, and the bands sorted.
+void GetSortedKey(const unsigned int* patterns, unsigned int* key)
+{
+	unsigned int bands[3][3];
+	for (unsigned int band = 0; band < 3; ++band)
+	{
+		unsigned int* rows = bands[band];
+		copy(patterns + band * 3, patterns + band * 3 + 3, rows);
+		if (rows[0] > rows[1]) swap(rows[0], rows[1]);
+		if (rows[1] > rows[2]) swap(rows[1], rows[2]);
+		if (rows[0] > rows[1]) swap(rows[0], rows[1]);
+	}
+
+	const unsigned int* order[3] = { bands[0], bands[1], bands[2] };
+	if (CompareBands(order[0], order[1]) > 0) swap(order[0], order[1]);
+	if (CompareBands(order[1], order[2]) > 0) swap(order[1], order[2]);
+	if (CompareBands(order[0], order[1]) > 0) swap(order[0], order[1]);
+
+	for (unsigned int i = 0; i < 3; ++i)
+	{
+		copy(order[i], order[i] + 3, key + i * 3);
+	}
+}
+
+//	Compares two sorted bands of patterns, the same way as CompareKeys().
+int CompareBands(const unsigned int* a, const unsigned int* b)
+{
+	for (unsigned int i = 0; i < 3; ++i)
+	{
+		if (a[i] != b[i])
+		{
+			return (a[i] < b[i]) ? -1 : 1;
+		}
+	}
+
+	return 0;
+}
+
+//	Returns every ordering of three rows that leaves their patterns in ascending order.
+void GetSortedRowOrders(const unsigned int* rows, const unsigned int* patterns, unsigned int orders[NUM_PERMUTATIONS][3], unsigned int& numOrders)
+{
+	numOrders = 0;
+	for (unsigned int p = 0; p < NUM_PERMUTATIONS; ++p)
+	{
+		unsigned int a = rows[PERMUTATIONS[p][0]];
+		unsigned int b = rows[PERMUTATIONS[p][1]];
+		unsigned int c = rows[PERMUTATIONS[p][2]];
+		if (patterns[a] <= patterns[b] && patterns[b] <= patterns[c])
+		{
+			orders[numOrders][0] = a;
+			orders[numOrders][1] = b;
+			orders[numOrders][2] = c;
+			++numOrders;
+		}
+	}
+}
+
+//	Compares two keys row by row.  Returns a negative number if a is smaller, 0 if they're equal, and a positive number if a is larger.
+int CompareKeys(const unsigned int* a, const unsigned int* b)
+{
+	for (unsigned int y = 0; y < LENGTH<3>; ++y)
+	{
+		if (a[y] != b[y])
+		{
+			return (a[y] < b[y]) ? -1 : 1;
+		}
+	}
+
+	return 0;
+}
+
+void ApplyTransform(const SymmetryTransform& transform, const Grid<3>& source, Grid<3>& target)
+{
+	for (unsigned int y = 0; y < LENGTH<3>; ++y)
+	{
+		for (unsigned int x = 0; x < LENGTH<3>; ++x)
+		{
+			unsigned int sourceY = transform.transpose ? transform.colMap[x] : transform.rowMap[y];
+			unsigned int sourceX = transform.transpose ? transform.rowMap[y] : transform.colMap[x];
+			target[y][x] = transform.valueMap[source[sourceY][sourceX]];
+		}
+	}
+}
+
+void InvertTransform(const SymmetryTransform& transform, const Grid<3>& target, Grid<3>& source)
+{
+	unsigned int inverseValues[MAX_VALUE<3> + 1];
+	for (unsigned int value = 0; value <= MAX_VALUE<3>; ++value)
+	{
+		inverseValues[transform.valueMap[value]] = value;
+	}
+
+	for (unsigned int y = 0; y < LENGTH<3>; ++y)
+	{
+		for (unsigned int x = 0; x < LENGTH<3>; ++x)
+		{
+			unsigned int sourceY = transform.transpose ? transform.colMap[x] : transform.rowMap[y];
+			unsigned int sourceX = transform.transpose ? transform.rowMap[y] : transform.colMap[x];
+			source[sourceY][sourceX] = inverseValues[target[y][x]];
+		}
+	}
+}
\ No newline at end of file
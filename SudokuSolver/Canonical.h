@@ -0,0 +1,31 @@
+#ifndef CANONICAL_H
+#define CANONICAL_H
+#pragma once
+
+#include "Constants.h"
+#include "Solver.h"
+
+//-------------------------------------------------------------
+//	SymmetryTransform maps a 9x9 grid onto an equivalent one: optionally transpose it, then rearrange rows and columns, then relabel values.
+//		Target cell (y, x) takes the relabelled value at cell (rowMap[y], colMap[x]) of the (transposed) source.
+//		Rows only move within their band and bands only move as a whole; likewise for columns and stacks.
+struct SymmetryTransform
+{
+	bool transpose;
+	unsigned int rowMap[LENGTH<3>];
+	unsigned int colMap[LENGTH<3>];
+	unsigned int valueMap[MAX_VALUE<3> + 1];	//	Source value to target value, with valueMap[0] = 0 for empty cells.
+};
+//-------------------------------------------------------------
+
+//	Interface functions
+//		Canonicalize() maps grid to the smallest equivalent grid under transposition, band, stack, row, and column permutations, and relabelling.
+//		Grids are compared first by their pattern of givens, one stack at a time with rows in sorted order, then by their values read
+//		row by row, relabelled in order of first appearance.  Two puzzles are equivalent exactly when their canonical forms are identical.
+//		NOTE: the transform's valueMap covers every value, including ones that don't appear in grid.
+//		NOTE: every value in grid must be at most MAX_VALUE<3>.
+void Canonicalize(const Grid<3>& grid, Grid<3>& canonical, SymmetryTransform& transform);
+void ApplyTransform(const SymmetryTransform& transform, const Grid<3>& source, Grid<3>& target);
+void InvertTransform(const SymmetryTransform& transform, const Grid<3>& target, Grid<3>& source);
+
+#endif	//	CANONICAL_H
\ No newline at end of file
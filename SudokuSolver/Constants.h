@@ -0,0 +1,61 @@
+#ifndef CONSTANTS_H
+#define CONSTANTS_H
+#pragma once
+
+#include <cstdint>		//	for uint16_t, uint32_t
+#include <type_traits>	//	for conditional
+
+//  BASE defines the scope of the puzzle, and is a template parameter so every board size gets its own constant-bounded code.
+//      For example, BASE = 3 indicates a puzzle of 3x3.
+//	MIN_BASE and MAX_BASE bound the sizes the runtime dispatcher will instantiate: 9x9, 16x16, and 25x25.
+const unsigned int MIN_BASE = 3;
+const unsigned int MAX_BASE = 5;
+
+//	LENGTH defines the number of cells per side of the puzzle.
+//		For example, LENGTH = 9 indicates a puzzle of 9x9 cells.
+template <unsigned int BASE>
+constexpr unsigned int LENGTH = BASE * BASE;
+
+//	MAX_VALUE defines the highest value that can be stored in a cell.  Cell values may range from 1, ..., MAX_VALUE.
+template <unsigned int BASE>
+constexpr unsigned int MAX_VALUE = LENGTH<BASE>;
+
+//	NUM_UNITS is the number of rows, columns, and squares that must each hold every value exactly once.
+//		Units are numbered 0, ..., LENGTH - 1 for rows, LENGTH, ..., 2*LENGTH - 1 for columns, and 2*LENGTH, ..., 3*LENGTH - 1 for squares.
+template <unsigned int BASE>
+constexpr unsigned int NUM_UNITS = 3 * LENGTH<BASE>;
+
+//	Candidate masks store one bit per cell value: bit (value - 1) is set if value is still available.
+//		9x9 puzzles use uint16_t; 16x16 and 25x25 puzzles use uint32_t.
+template <unsigned int BASE>
+using CandidateMask = typename std::conditional<(MAX_VALUE<BASE> < 16), uint16_t, uint32_t>::type;
+
+//	ALL_CANDIDATES has a bit set for every value 1, ..., MAX_VALUE.
+template <unsigned int BASE>
+constexpr CandidateMask<BASE> ALL_CANDIDATES = static_cast<CandidateMask<BASE>>((1ull << MAX_VALUE<BASE>) - 1);
+
+//	Number of guesses between wall-clock checks, so that reading the clock stays out of the hot path.
+const unsigned long long DEADLINE_CHECK_INTERVAL = 64;
+
+//	Number of guesses between checks for idle threads during a parallel search.
+const unsigned long long DONATION_CHECK_INTERVAL = 16;
+
+//	Solution limit for a uniqueness check: finding a second solution is enough to reject a puzzle.
+const unsigned long long UNIQUENESS_LIMIT = 2;
+
+//	Outcome of a bounded search.
+enum SolveResult
+{
+	Solved,
+	Unsolvable,
+	BudgetExhausted		//	The node budget or deadline ran out, or the search was cancelled, before it finished.
+};
+
+//	Search algorithm used to solve a puzzle.
+enum SolverBackend
+{
+	CandidateSearch,	//	Backtracking over candidate masks in the Reference Lists, with constraint propagation.
+	DancingLinksSearch	//	Algorithm X over an exact-cover matrix.
+};
+
+#endif	//	CONSTANTS_H
\ No newline at end of file
@@ -0,0 +1,84 @@
+#ifndef DANCINGLINKS_H
+#define DANCINGLINKS_H
+#pragma once
+
+#include <vector>	//	for vector
+#include "Constants.h"
+#include "Solver.h"
+
+//	NUM_COLUMNS is the number of exact-cover constraints: every cell holds one value, and every row, column, and square holds each value once.
+//		Columns are numbered 0, ..., LENGTH^2 - 1 for cells, then LENGTH^2 each for row/value, column/value, and square/value pairs.
+template <unsigned int BASE>
+constexpr unsigned int NUM_COLUMNS = 4 * LENGTH<BASE> * LENGTH<BASE>;
+
+//	NUM_ROWS is the number of candidate placements, one per cell and value.
+template <unsigned int BASE>
+constexpr unsigned int NUM_ROWS = LENGTH<BASE> * LENGTH<BASE> * MAX_VALUE<BASE>;
+
+//-------------------------------------------------------------
+//	DancingLinks class solves a puzzle as an exact-cover problem with Knuth's Algorithm X.
+//		Every node lives in one arena and links to its neighbours by index, so the whole matrix is a single allocation.
+//		The search keeps its own stack, so after a solution it can be resumed to look for the next one.
+template <unsigned int BASE>
+class DancingLinks
+{
+	public:
+		//	Create the full matrix: every candidate placement, with nothing covered.
+		DancingLinks();
+
+		//	Select the placements for every given in grid.
+		//	Returns false if the givens are out of range or conflict with each other.
+		bool InitMatrix(const Grid<BASE>& grid);
+
+		//	Search until a solution is found, the matrix is exhausted, or the limits are reached.
+		//		After a Solved result, calling again resumes with the next solution.
+		//		NOTE: a search that returns BudgetExhausted can't be resumed.
+		SolveResult Search(const SearchLimits& limits);
+
+		//	Write the placements chosen by the search into grid.  The givens are already there.
+		void CopySolution(Grid<BASE>& grid) const;
+
+		//	Returns the number of placements tried so far, checked against SearchLimits::maxNodes.
+		unsigned long long GetNodes() const { return _searchNodes; };
+
+	private:
+		//	Index of the root header; column headers follow it, then four nodes per candidate placement.
+		static const unsigned int ROOT = 0;
+		static const unsigned int FIRST_ROW_NODE = 1 + NUM_COLUMNS<BASE>;
+
+		//	One cell of the sparse matrix.  Column headers use column to point at themselves.
+		struct Node
+		{
+			unsigned int left;
+			unsigned int right;
+			unsigned int up;
+			unsigned int down;
+			unsigned int column;
+		};
+
+		void LinkRow(unsigned int row, const unsigned int columns[4]);
+		void Cover(unsigned int column);
+		void Uncover(unsigned int column);
+		void SelectRow(unsigned int node);
+		void UnselectRow(unsigned int node);
+		unsigned int ChooseColumn() const;
+
+		std::vector<Node> _nodes;
+		std::vector<unsigned int> _sizes;		//	Rows left in each column, indexed by header.
+		std::vector<unsigned int> _chosen;		//	Node of the row being tried at each level, or the column header before the first.
+		unsigned long long _searchNodes;
+		bool _resume;							//	True after a solution, so the next Search() moves past it first.
+};
+//-------------------------------------------------------------
+
+//	Interface functions
+//		Solves grid in place with the Dancing Links backend.  Same results and limits as SolveSudoku().
+template <unsigned int BASE>
+SolveResult SolveExactCover(Grid<BASE>& grid, const SearchLimits& limits);
+//		Counts solutions with the Dancing Links backend.  Same results and limits as CountSolutions().
+template <unsigned int BASE>
+SolveResult CountExactCovers(const Grid<BASE>& grid, const SearchLimits& limits, unsigned long long limit, unsigned long long& count);
+
+#include "DancingLinks.inl"
+
+#endif	//	DANCINGLINKS_H
\ No newline at end of file
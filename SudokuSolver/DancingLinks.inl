@@ -0,0 +1,299 @@
+//-------------------------------------------------------------
+template <unsigned int BASE>
+DancingLinks<BASE>::DancingLinks() : _nodes(FIRST_ROW_NODE + 4 * NUM_ROWS<BASE>), _sizes(FIRST_ROW_NODE, 0), _searchNodes(0), _resume(false)
+{
+	//	The root and the column headers form one circular list; each header starts as an empty vertical list.
+	for (unsigned int header = ROOT; header < FIRST_ROW_NODE; ++header)
+	{
+		_nodes[header].left = (header == ROOT) ? FIRST_ROW_NODE - 1 : header - 1;
+		_nodes[header].right = (header == FIRST_ROW_NODE - 1) ? ROOT : header + 1;
+		_nodes[header].up = header;
+		_nodes[header].down = header;
+		_nodes[header].column = header;
+	}
+
+	//	Placing value at (x, y) satisfies one constraint of each kind.
+	const unsigned int area = LENGTH<BASE> * LENGTH<BASE>;
+	for (unsigned int y = 0; y < LENGTH<BASE>; ++y)
+	{
+		for (unsigned int x = 0; x < LENGTH<BASE>; ++x)
+		{
+			Cursor<BASE> cursor(x, y);
+			for (unsigned int value = 1; value <= MAX_VALUE<BASE>; ++value)
+			{
+				unsigned int columns[4] = {
+					y * LENGTH<BASE> + x,
+					area + y * LENGTH<BASE> + (value - 1),
+					2 * area + x * LENGTH<BASE> + (value - 1),
+					3 * area + cursor.GetSquare() * LENGTH<BASE> + (value - 1)
+				};
+				LinkRow((y * LENGTH<BASE> + x) * MAX_VALUE<BASE> + (value - 1), columns);
+			}
+		}
+	}
+
+	_chosen.reserve(LENGTH<BASE> * LENGTH<BASE>);
+}
+
+//	Appends the four nodes of a candidate placement to the bottom of their columns, linked into a circular row.
+template <unsigned int BASE>
+void DancingLinks<BASE>::LinkRow(unsigned int row, const unsigned int columns[4])
+{
+	unsigned int first = FIRST_ROW_NODE + 4 * row;
+	for (unsigned int k = 0; k < 4; ++k)
+	{
+		unsigned int node = first + k;
+		unsigned int header = 1 + columns[k];
+
+		_nodes[node].left = first + (k + 3) % 4;
+		_nodes[node].right = first + (k + 1) % 4;
+		_nodes[node].up = _nodes[header].up;
+		_nodes[node].down = header;
+		_nodes[node].column = header;
+
+		_nodes[_nodes[header].up].down = node;
+		_nodes[header].up = node;
+		_sizes[header]++;
+	}
+}
+
+template <unsigned int BASE>
+bool DancingLinks<BASE>::InitMatrix(const Grid<BASE>& grid)
+{
+	Cursor<BASE> cursor;
+	do
+	{
+		unsigned int value = grid[cursor.GetY()][cursor.GetX()];
+		if (value == 0)
+		{
+			continue;
+		}
+		if (value > MAX_VALUE<BASE>)
+		{
+			return false;
+		}
+
+		//	A given whose constraints are already satisfied clashes with an earlier given.
+		unsigned int node = FIRST_ROW_NODE + 4 * ((cursor.GetY() * LENGTH<BASE> + cursor.GetX()) * MAX_VALUE<BASE> + (value - 1));
+		for (unsigned int k = 0; k < 4; ++k)
+		{
+			unsigned int header = _nodes[node + k].column;
+			if (_nodes[_nodes[header].left].right != header)
+			{
+				return false;
+			}
+		}
+
+		Cover(_nodes[node].column);
+		SelectRow(node);
+	} while (cursor.Increment());
+
+	return true;
+}
+//-------------------------------------------------------------
+
+//-------------------------------------------------------------
+//	Removes a column from the header list, and every row that satisfies it from the other columns.
+template <unsigned int BASE>
+void DancingLinks<BASE>::Cover(unsigned int column)
+{
+	COUNT_SEARCH_STAT(propagations);
+	_nodes[_nodes[column].right].left = _nodes[column].left;
+	_nodes[_nodes[column].left].right = _nodes[column].right;
+
+	for (unsigned int i = _nodes[column].down; i != column; i = _nodes[i].down)
+	{
+		for (unsigned int j = _nodes[i].right; j != i; j = _nodes[j].right)
+		{
+			_nodes[_nodes[j].down].up = _nodes[j].up;
+			_nodes[_nodes[j].up].down = _nodes[j].down;
+			_sizes[_nodes[j].column]--;
+		}
+	}
+}
+
+//	Reverses Cover(), relinking in exactly the opposite order.
+template <unsigned int BASE>
+void DancingLinks<BASE>::Uncover(unsigned int column)
+{
+	for (unsigned int i = _nodes[column].up; i != column; i = _nodes[i].up)
+	{
+		for (unsigned int j = _nodes[i].left; j != i; j = _nodes[j].left)
+		{
+			_sizes[_nodes[j].column]++;
+			_nodes[_nodes[j].down].up = j;
+			_nodes[_nodes[j].up].down = j;
+		}
+	}
+
+	_nodes[_nodes[column].right].left = column;
+	_nodes[_nodes[column].left].right = column;
+}
+
+//	Covers the other columns of a row whose own column is already covered.
+template <unsigned int BASE>
+void DancingLinks<BASE>::SelectRow(unsigned int node)
+{
+	for (unsigned int j = _nodes[node].right; j != node; j = _nodes[j].right)
+	{
+		Cover(_nodes[j].column);
+	}
+}
+
+template <unsigned int BASE>
+void DancingLinks<BASE>::UnselectRow(unsigned int node)
+{
+	for (unsigned int j = _nodes[node].left; j != node; j = _nodes[j].left)
+	{
+		Uncover(_nodes[j].column);
+	}
+}
+
+//	Returns the uncovered column with the fewest rows left.
+//		NOTE: the matrix must have at least one uncovered column.
+template <unsigned int BASE>
+unsigned int DancingLinks<BASE>::ChooseColumn() const
+{
+	unsigned int best = _nodes[ROOT].right;
+	for (unsigned int column = _nodes[best].right; column != ROOT && _sizes[best] > 1; column = _nodes[column].right)
+	{
+		if (_sizes[column] < _sizes[best])
+		{
+			best = column;
+		}
+	}
+
+	return best;
+}
+//-------------------------------------------------------------
+
+//-------------------------------------------------------------
+template <unsigned int BASE>
+SolveResult DancingLinks<BASE>::Search(const SearchLimits& limits)
+{
+	bool advance = _resume;
+	_resume = false;
+
+	for (;;)
+	{
+		//	Branch on the most constrained column, unless we're moving past a solution.
+		if (!advance)
+		{
+			if (_nodes[ROOT].right == ROOT)
+			{
+				_resume = true;
+				return Solved;
+			}
+
+			unsigned int column = ChooseColumn();
+			Cover(column);
+			_chosen.push_back(column);
+		}
+		advance = false;
+
+		//	Move to the next row in the deepest column, backtracking out of columns that have none left.
+		for (;;)
+		{
+			if (_chosen.empty())
+			{
+				return Unsolvable;
+			}
+
+			unsigned int node = _chosen.back();
+			if (node != _nodes[node].column)
+			{
+				UnselectRow(node);
+			}
+
+			node = _nodes[node].down;
+			if (node != _nodes[node].column)
+			{
+				_chosen.back() = node;
+				break;
+			}
+
+			Uncover(node);
+			_chosen.pop_back();
+			COUNT_SEARCH_STAT(backtracks);
+		}
+
+		//	Stop if we've exceeded the budget or been cancelled.
+		++_searchNodes;
+		COUNT_SEARCH_STAT(nodes);
+		if (limits.maxNodes != 0 && _searchNodes > limits.maxNodes)
+		{
+			return BudgetExhausted;
+		}
+		if (_searchNodes % DEADLINE_CHECK_INTERVAL == 0 && std::chrono::steady_clock::now() >= limits.deadline)
+		{
+			return BudgetExhausted;
+		}
+		if (limits.cancelled != nullptr && limits.cancelled->load(std::memory_order_relaxed))
+		{
+			return BudgetExhausted;
+		}
+
+		SelectRow(_chosen.back());
+	}
+}
+
+template <unsigned int BASE>
+void DancingLinks<BASE>::CopySolution(Grid<BASE>& grid) const
+{
+	for (size_t level = 0; level < _chosen.size(); ++level)
+	{
+		//	NOTE: Intentional integer division
+		unsigned int row = (_chosen[level] - FIRST_ROW_NODE) / 4;
+		unsigned int cell = row / MAX_VALUE<BASE>;
+		grid[cell / LENGTH<BASE>][cell % LENGTH<BASE>] = row % MAX_VALUE<BASE> + 1;
+	}
+}
+//-------------------------------------------------------------
+
+//	Solves grid in place within the given limits.
+//	If the result is not Solved, grid is left in its initial state.  An invalid initial state is reported as Unsolvable.
+template <unsigned int BASE>
+SolveResult SolveExactCover(Grid<BASE>& grid, const SearchLimits& limits)
+{
+	DancingLinks<BASE> matrix;
+	if (!matrix.InitMatrix(grid))
+	{
+		return Unsolvable;
+	}
+
+	SolveResult result = matrix.Search(limits);
+	if (result == Solved)
+	{
+		matrix.CopySolution(grid);
+	}
+
+	return result;
+}
+
+template <unsigned int BASE>
+SolveResult CountExactCovers(const Grid<BASE>& grid, const SearchLimits& limits, unsigned long long limit, unsigned long long& count)
+{
+	count = 0;
+
+	DancingLinks<BASE> matrix;
+	if (!matrix.InitMatrix(grid))
+	{
+		return Unsolvable;
+	}
+
+	SolveResult result;
+	while ((result = matrix.Search(limits)) == Solved)
+	{
+		if (++count == limit)
+		{
+			return Solved;
+		}
+	}
+
+	if (result == BudgetExhausted)
+	{
+		return BudgetExhausted;
+	}
+
+	return (count > 0) ? Solved : Unsolvable;
+}
\ No newline at end of file
@@ -0,0 +1,99 @@
+#ifndef GENERATOR_H
+#define GENERATOR_H
+#pragma once
+
+#include <cstddef>	//	for size_t
+#include <cstdint>	//	for uint32_t
+#include <atomic>	//	for atomic
+#include <thread>	//	for thread
+#include <random>	//	for mt19937_64, seed_seq, uniform_int_distribution
+#include <algorithm>	//	for max, min, shuffle
+#include <numeric>	//	for iota
+#include <limits>	//	for numeric_limits
+#include <vector>	//	for vector
+#include "Constants.h"
+#include "Solver.h"
+
+//	Guesses allowed while filling a random grid before starting over with fresh random choices.
+//		Almost every grid fills with no backtracking at all; the odd dead end is cheaper to abandon than to search out.
+template <unsigned int BASE>
+constexpr unsigned long long FILL_NODE_LIMIT = 4 * LENGTH<BASE> * LENGTH<BASE>;
+
+//	Most guesses a Medium puzzle may need.  Easy puzzles need none; Hard puzzles need more than this.
+const unsigned long long MEDIUM_MAX_GUESSES = 4;
+//	Stands in for the most guesses of a band with no upper bound.
+const unsigned long long NO_MAX_GUESSES = std::numeric_limits<unsigned long long>::max();
+
+//	Difficulty band, rated by the number of guesses candidate search needs to solve the puzzle (see RatePuzzle()).
+enum PuzzleDifficulty
+{
+	AnyDifficulty,
+	Easy,		//	Solved by propagation alone.
+	Medium,		//	1, ..., MEDIUM_MAX_GUESSES guesses.
+	Hard		//	More than MEDIUM_MAX_GUESSES guesses.
+};
+
+//	Settings for generating puzzles.
+struct GeneratorOptions
+{
+	//	Create options that dig every puzzle as far as it will go, at any difficulty, on every core.
+	GeneratorOptions() : targetClues(0), difficulty(AnyDifficulty), numThreads(0), seed(0), maxNodesPerCheck(0) {};
+
+	unsigned int targetClues;				//	Clues to stop digging at, or 0 to dig until no clue can be removed.
+	PuzzleDifficulty difficulty;
+	unsigned int numThreads;				//	Number of worker threads, or 0 to use one per hardware thread.
+	unsigned long long seed;				//	Every puzzle depends only on the seed and its index, not on the number of threads.
+	unsigned long long maxNodesPerCheck;	//	Maximum guesses per uniqueness check, or 0 for no limit.  A clue whose check runs out is kept.
+};
+
+//	Candidate order for filling random grids: a random untried candidate each time, so each cell's candidates are tried
+//	in a shuffled order.
+struct RandomOrder
+{
+	explicit RandomOrder(std::mt19937_64& engine) : rng(&engine) {};
+
+	unsigned int NextCandidate(unsigned int remaining)
+	{
+		unsigned int skip = std::uniform_int_distribution<unsigned int>(0, CountCandidates(remaining) - 1)(*rng);
+		for (; skip > 0; --skip)
+		{
+			remaining &= remaining - 1;
+		}
+		return LowestCandidate(remaining);
+	};
+
+	std::mt19937_64* rng;
+};
+
+//	Interface functions
+//		GeneratePuzzles() fills puzzles with count puzzles, each with exactly one solution, generated in parallel.
+//		GeneratePuzzle() makes one puzzle (and its solution) from rng.  Grids that can't be dug down to the target clue count,
+//		or that land outside the difficulty band, are discarded and another grid is tried.
+//		NOTE: unreachable targets never finish.  Random 9x9 grids rarely dig below about 22 clues, and few dug puzzles are Hard.
+template <unsigned int BASE>
+void GeneratePuzzles(size_t count, const GeneratorOptions& options, std::vector<Grid<BASE>>& puzzles);
+template <unsigned int BASE>
+void GeneratePuzzle(std::mt19937_64& rng, const GeneratorOptions& options, Grid<BASE>& puzzle, Grid<BASE>& solution);
+//		RatePuzzle() returns the number of guesses candidate search makes before finding the first solution of a valid puzzle.
+template <unsigned int BASE>
+unsigned long long RatePuzzle(const Grid<BASE>& puzzle);
+
+//	Helper functions
+template <unsigned int BASE>
+void FillRandomGrid(std::mt19937_64& rng, Grid<BASE>& grid);
+template <unsigned int BASE>
+SolveResult FillRandomly(Grid<BASE>& grid, RefLists<BASE>* ref, Trail<BASE>* trail, std::mt19937_64& rng);
+template <unsigned int BASE>
+unsigned int DigHoles(std::mt19937_64& rng, const GeneratorOptions& options, Grid<BASE>& puzzle);
+template <unsigned int BASE>
+bool HasOtherSolution(Grid<BASE>& puzzle, RefLists<BASE>* ref, Trail<BASE>* trail, unsigned int x, unsigned int y, unsigned int value, const SearchLimits& limits);
+template <unsigned int BASE>
+SolveResult CountGuesses(Grid<BASE>& puzzle, RefLists<BASE>* ref, Trail<BASE>* trail, const SearchLimits& limits, unsigned long long& guesses);
+bool IsInDifficultyBand(unsigned long long guesses, PuzzleDifficulty difficulty);
+unsigned long long GetMaxGuesses(PuzzleDifficulty difficulty);
+template <unsigned int BASE>
+void RunGeneratorWorker(std::atomic<size_t>* next, size_t count, const GeneratorOptions* options, std::vector<Grid<BASE>>* puzzles);
+
+#include "Generator.inl"
+
+#endif	//	GENERATOR_H
\ No newline at end of file
@@ -0,0 +1,294 @@
+//-------------------------------------------------------------
+//	Generates count puzzles into puzzles, dealing puzzle indices out to numThreads workers as they finish.
+template <unsigned int BASE>
+void GeneratePuzzles(size_t count, const GeneratorOptions& options, std::vector<Grid<BASE>>& puzzles)
+{
+	puzzles.resize(count);
+
+	unsigned int numThreads = options.numThreads;
+	if (numThreads == 0)
+	{
+		numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+	}
+	numThreads = static_cast<unsigned int>(std::min<size_t>(numThreads, std::max<size_t>(count, 1)));
+
+	std::atomic<size_t> next(0);
+	std::vector<std::thread> workers;
+	for (unsigned int workerID = 0; workerID < numThreads; ++workerID)
+	{
+		workers.push_back(std::thread(RunGeneratorWorker<BASE>, &next, count, &options, &puzzles));
+	}
+	for (unsigned int workerID = 0; workerID < numThreads; ++workerID)
+	{
+		workers[workerID].join();
+	}
+}
+
+//	Generates puzzles until none are left.  Each worker owns its random engine, reseeded per puzzle from the seed and index.
+template <unsigned int BASE>
+void RunGeneratorWorker(std::atomic<size_t>* next, size_t count, const GeneratorOptions* options, std::vector<Grid<BASE>>* puzzles)
+{
+	std::mt19937_64 rng;
+	Grid<BASE> solution;
+
+	for (;;)
+	{
+		size_t index = next->fetch_add(1);
+		if (index >= count)
+		{
+			return;
+		}
+
+		std::seed_seq seeds = {
+			static_cast<uint32_t>(options->seed), static_cast<uint32_t>(options->seed >> 32),
+			static_cast<uint32_t>(index), static_cast<uint32_t>(static_cast<unsigned long long>(index) >> 32)
+		};
+		rng.seed(seeds);
+
+		GeneratePuzzle(rng, *options, (*puzzles)[index], solution);
+	}
+}
+
+template <unsigned int BASE>
+void GeneratePuzzle(std::mt19937_64& rng, const GeneratorOptions& options, Grid<BASE>& puzzle, Grid<BASE>& solution)
+{
+	for (;;)
+	{
+		FillRandomGrid(rng, solution);
+
+		puzzle = solution;
+		unsigned int clues = DigHoles(rng, options, puzzle);
+		if (options.targetClues != 0 && clues > options.targetClues)
+		{
+			continue;
+		}
+
+		//	Digging already kept the puzzle at or below the band's most guesses; check it has reached the band's fewest.
+		if (options.difficulty == AnyDifficulty || IsInDifficultyBand(RatePuzzle(puzzle), options.difficulty))
+		{
+			return;
+		}
+	}
+}
+
+template <unsigned int BASE>
+unsigned long long RatePuzzle(const Grid<BASE>& puzzle)
+{
+	Grid<BASE> board = puzzle;
+	RefLists<BASE> reference;
+	if (!reference.InitLists(board))
+	{
+		return 0;
+	}
+
+	Trail<BASE> trail;
+	trail.reserve(LENGTH<BASE> * LENGTH<BASE>);
+
+	unsigned long long guesses;
+	CountGuesses(board, &reference, &trail, SearchLimits(), guesses);
+	return guesses;
+}
+//-------------------------------------------------------------
+
+//-------------------------------------------------------------
+//	Fills grid with a random complete solution, starting over whenever the random choices run into a dead end.
+template <unsigned int BASE>
+void FillRandomGrid(std::mt19937_64& rng, Grid<BASE>& grid)
+{
+	for (;;)
+	{
+		grid = Grid<BASE>();
+		RefLists<BASE> reference;
+
+		Trail<BASE> trail;
+		trail.reserve(LENGTH<BASE> * LENGTH<BASE>);
+
+		if (FillRandomly(grid, &reference, &trail, rng) == Solved)
+		{
+			return;
+		}
+	}
+}
+
+//	Completes grid by the iterative search, trying each cell's candidates in a random order.
+//	Returns BudgetExhausted after FILL_NODE_LIMIT guesses.  Unless the result is Solved, the caller undoes the trail.
+template <unsigned int BASE>
+SolveResult FillRandomly(Grid<BASE>& grid, RefLists<BASE>* ref, Trail<BASE>* trail, std::mt19937_64& rng)
+{
+	unsigned int cellX;
+	unsigned int cellY;
+	CandidateMask<BASE> candidates;
+
+	if (!Propagate(grid, ref, trail))
+	{
+		return Unsolvable;
+	}
+	if (!FindMostConstrainedCell(grid, ref, cellX, cellY, candidates))
+	{
+		return Solved;
+	}
+	if (candidates == 0)
+	{
+		return Unsolvable;
+	}
+
+	SearchLimits limits;
+	limits.maxNodes = FILL_NODE_LIMIT<BASE>;
+
+	SearchStack<BASE> stack;
+	stack.nodes = 0;
+	stack.frames.reserve(LENGTH<BASE> * LENGTH<BASE>);
+
+	SearchFrame<BASE> root = { cellX, cellY, candidates, trail->size() };
+	stack.frames.push_back(root);
+
+	NoDonor donor;
+	RandomOrder order(rng);
+	return ContinueSearch(grid, ref, trail, &stack, limits, &donor, &order);
+}
+//-------------------------------------------------------------
+
+//-------------------------------------------------------------
+//	Removes clues from a solved grid in random order, keeping each removal only if the solution stays unique (and the
+//	puzzle stays within the difficulty band's most guesses).  Stops at the target clue count, and returns the clues left.
+//		The Reference Lists follow the puzzle from one removal to the next, and each check is undone through the trail,
+//		so no check has to rebuild the puzzle's state from scratch.
+template <unsigned int BASE>
+unsigned int DigHoles(std::mt19937_64& rng, const GeneratorOptions& options, Grid<BASE>& puzzle)
+{
+	RefLists<BASE> reference;
+	reference.InitLists(puzzle);
+
+	Trail<BASE> trail;
+	trail.reserve(LENGTH<BASE> * LENGTH<BASE>);
+
+	SearchLimits limits;
+	limits.maxNodes = options.maxNodesPerCheck;
+	unsigned long long maxGuesses = GetMaxGuesses(options.difficulty);
+
+	std::vector<unsigned int> cells(LENGTH<BASE> * LENGTH<BASE>);
+	std::iota(cells.begin(), cells.end(), 0);
+	std::shuffle(cells.begin(), cells.end(), rng);
+
+	unsigned int clues = LENGTH<BASE> * LENGTH<BASE>;
+	for (size_t i = 0; i < cells.size() && clues > options.targetClues; ++i)
+	{
+		//	NOTE: Intentional integer division
+		unsigned int x = cells[i] % LENGTH<BASE>;
+		unsigned int y = cells[i] / LENGTH<BASE>;
+		unsigned int value = puzzle[y][x];
+
+		Cursor<BASE> cursor(x, y);
+		puzzle[y][x] = 0;
+		reference.RemoveValue(value, &cursor);
+
+		//	A puzzle that propagation alone can finish is unique, so rating it first can skip the uniqueness check entirely.
+		bool removable;
+		unsigned long long guesses = 0;
+		if (maxGuesses != NO_MAX_GUESSES && CountGuesses(puzzle, &reference, &trail, limits, guesses) != Solved)
+		{
+			removable = false;
+		}
+		else if (guesses > maxGuesses)
+		{
+			removable = false;
+		}
+		else
+		{
+			removable = (maxGuesses != NO_MAX_GUESSES && guesses == 0) || !HasOtherSolution(puzzle, &reference, &trail, x, y, value, limits);
+		}
+
+		if (removable)
+		{
+			--clues;
+		}
+		else
+		{
+			puzzle[y][x] = value;
+			reference.AddValue(value, &cursor);
+		}
+	}
+
+	return clues;
+}
+
+//	Returns true unless the puzzle is known to have no solution with something other than value at (x, y).
+//		Since the puzzle had a unique solution before (x, y) was emptied, this is exactly whether emptying it lost uniqueness.
+//		A check that runs out of budget counts as having found one, so the clue is kept.
+template <unsigned int BASE>
+bool HasOtherSolution(Grid<BASE>& puzzle, RefLists<BASE>* ref, Trail<BASE>* trail, unsigned int x, unsigned int y, unsigned int value, const SearchLimits& limits)
+{
+	size_t mark = trail->size();
+	EliminateFromCell(puzzle, ref, trail, x, y, ValueToMask<BASE>(value));
+
+	SolveResult result = IterativelySolve(puzzle, ref, trail, limits);
+	UndoTrail(puzzle, ref, trail, mark);
+
+	return result != Unsolvable;
+}
+
+//	Solves the puzzle, counting the guesses made before the first solution, then undoes everything through the trail.
+template <unsigned int BASE>
+SolveResult CountGuesses(Grid<BASE>& puzzle, RefLists<BASE>* ref, Trail<BASE>* trail, const SearchLimits& limits, unsigned long long& guesses)
+{
+	guesses = 0;
+	size_t mark = trail->size();
+
+	unsigned int cellX;
+	unsigned int cellY;
+	CandidateMask<BASE> candidates;
+
+	SolveResult result;
+	if (!Propagate(puzzle, ref, trail))
+	{
+		result = Unsolvable;
+	}
+	else if (!FindMostConstrainedCell(puzzle, ref, cellX, cellY, candidates))
+	{
+		result = Solved;
+	}
+	else if (candidates == 0)
+	{
+		result = Unsolvable;
+	}
+	else
+	{
+		SearchStack<BASE> stack;
+		stack.nodes = 0;
+		stack.frames.reserve(LENGTH<BASE> * LENGTH<BASE>);
+
+		SearchFrame<BASE> root = { cellX, cellY, candidates, trail->size() };
+		stack.frames.push_back(root);
+
+		NoDonor donor;
+		result = ContinueSearch(puzzle, ref, trail, &stack, limits, &donor);
+		guesses = stack.nodes;
+	}
+
+	UndoTrail(puzzle, ref, trail, mark);
+	return result;
+}
+
+//	Returns true if a puzzle needing this many guesses belongs to the difficulty band.
+inline bool IsInDifficultyBand(unsigned long long guesses, PuzzleDifficulty difficulty)
+{
+	switch (difficulty)
+	{
+		case Easy:		return guesses == 0;
+		case Medium:	return guesses >= 1 && guesses <= MEDIUM_MAX_GUESSES;
+		case Hard:		return guesses > MEDIUM_MAX_GUESSES;
+		default:		return true;
+	}
+}
+
+//	Returns the most guesses a puzzle in the difficulty band may need, or NO_MAX_GUESSES if there's no upper bound.
+inline unsigned long long GetMaxGuesses(PuzzleDifficulty difficulty)
+{
+	switch (difficulty)
+	{
+		case Easy:		return 0;
+		case Medium:	return MEDIUM_MAX_GUESSES;
+		default:		return NO_MAX_GUESSES;
+	}
+}
+//-------------------------------------------------------------
\ No newline at end of file
@@ -0,0 +1,210 @@
+#include <cstdint>	//	for uint16_t
+#include "Constants.h"
+#include "Solver.h"
+#include "Lockstep.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>	//	for AVX2 intrinsics
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LOCKSTEP_SSE2
+#include <emmintrin.h>	//	for SSE2 intrinsics
+#endif
+
+using namespace std;
+
+//-------------------------------------------------------------
+//	LaneVector holds one 16-bit candidate mask per puzzle.  Comparisons return all ones in the lanes where they hold.
+#if defined(__AVX2__)
+typedef __m256i LaneVector;
+
+static inline LaneVector LoadLanes(const uint16_t* lanes) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lanes)); }
+static inline void StoreLanes(uint16_t* lanes, LaneVector v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), v); }
+static inline LaneVector Broadcast(uint16_t value) { return _mm256_set1_epi16(static_cast<short>(value)); }
+static inline LaneVector And(LaneVector a, LaneVector b) { return _mm256_and_si256(a, b); }
+static inline LaneVector Or(LaneVector a, LaneVector b) { return _mm256_or_si256(a, b); }
+static inline LaneVector Xor(LaneVector a, LaneVector b) { return _mm256_xor_si256(a, b); }
+static inline LaneVector AndNot(LaneVector a, LaneVector b) { return _mm256_andnot_si256(b, a); }
+static inline LaneVector Decrement(LaneVector a) { return _mm256_sub_epi16(a, _mm256_set1_epi16(1)); }
+static inline LaneVector EqualsZero(LaneVector a) { return _mm256_cmpeq_epi16(a, _mm256_setzero_si256()); }
+static inline bool IsZero(LaneVector a) { return _mm256_testz_si256(a, a) != 0; }
+#elif defined(LOCKSTEP_SSE2)
+typedef __m128i LaneVector;
+
+static inline LaneVector LoadLanes(const uint16_t* lanes) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes)); }
+static inline void StoreLanes(uint16_t* lanes, LaneVector v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), v); }
+static inline LaneVector Broadcast(uint16_t value) { return _mm_set1_epi16(static_cast<short>(value)); }
+static inline LaneVector And(LaneVector a, LaneVector b) { return _mm_and_si128(a, b); }
+static inline LaneVector Or(LaneVector a, LaneVector b) { return _mm_or_si128(a, b); }
+static inline LaneVector Xor(LaneVector a, LaneVector b) { return _mm_xor_si128(a, b); }
+static inline LaneVector AndNot(LaneVector a, LaneVector b) { return _mm_andnot_si128(b, a); }
+static inline LaneVector Decrement(LaneVector a) { return _mm_sub_epi16(a, _mm_set1_epi16(1)); }
+static inline LaneVector EqualsZero(LaneVector a) { return _mm_cmpeq_epi16(a, _mm_setzero_si128()); }
+static inline bool IsZero(LaneVector a) { return _mm_movemask_epi8(_mm_cmpeq_epi8(a, _mm_setzero_si128())) == 0xFFFF; }
+#else
+//	Plain C++ fallback, written as simple loops so the compiler can still vectorize it.
+struct LaneVector
+{
+	uint16_t lanes[LOCKSTEP_LANES];
+};
+
+static inline LaneVector LoadLanes(const uint16_t* lanes) { LaneVector r; for (unsigned int i = 0; i < LOCKSTEP_LANES; ++i) r.lanes[i] = lanes[i]; return r; }
+static inline void StoreLanes(uint16_t* lanes, LaneVector v) { for (unsigned int i = 0; i < LOCKSTEP_LANES; ++i) lanes[i] = v.lanes[i]; }
+static inline LaneVector Broadcast(uint16_t value) { LaneVector r; for (unsigned int i = 0; i < LOCKSTEP_LANES; ++i) r.lanes[i] = value; return r; }
+static inline LaneVector And(LaneVector a, LaneVector b) { for (unsigned int i = 0; i < LOCKSTEP_LANES; ++i) a.lanes[i] &= b.lanes[i]; return a; }
+static inline LaneVector Or(LaneVector a, LaneVector b) { for (unsigned int i = 0; i < LOCKSTEP_LANES; ++i) a.lanes[i] |= b.lanes[i]; return a; }
+static inline LaneVector Xor(LaneVector a, LaneVector b) { for (unsigned int i = 0; i < LOCKSTEP_LANES; ++i) a.lanes[i] ^= b.lanes[i]; return a; }
+static inline LaneVector AndNot(LaneVector a, LaneVector b) { for (unsigned int i = 0; i < LOCKSTEP_LANES; ++i) a.lanes[i] &= ~b.lanes[i]; return a; }
+static inline LaneVector Decrement(LaneVector a) { for (unsigned int i = 0; i < LOCKSTEP_LANES; ++i) a.lanes[i] -= 1; return a; }
+static inline LaneVector EqualsZero(LaneVector a) { for (unsigned int i = 0; i < LOCKSTEP_LANES; ++i) a.lanes[i] = (a.lanes[i] == 0) ? 0xFFFF : 0; return a; }
+static inline bool IsZero(LaneVector a) { uint16_t any = 0; for (unsigned int i = 0; i < LOCKSTEP_LANES; ++i) any |= a.lanes[i]; return any == 0; }
+#endif
+
+//	Returns all ones in the lanes that aren't zero.
+static inline LaneVector NonZeroLanes(LaneVector a)
+{
+	return Xor(EqualsZero(a), Broadcast(0xFFFF));
+}
+
+//	Returns the candidate in the lanes that have exactly one, and zero elsewhere.
+static inline LaneVector GetSingles(LaneVector mask)
+{
+	LaneVector single = AndNot(EqualsZero(And(mask, Decrement(mask))), EqualsZero(mask));
+	return And(mask, single);
+}
+//-------------------------------------------------------------
+
+//	Cell indices (y * LENGTH + x) of every unit, numbered as in GetUnitCell().
+struct UnitTable
+{
+	UnitTable()
+	{
+		for (unsigned int unit = 0; unit < NUM_UNITS<3>; ++unit)
+		{
+			for (unsigned int index = 0; index < LENGTH<3>; ++index)
+			{
+				unsigned int x;
+				unsigned int y;
+				GetUnitCell<3>(unit, index, x, y);
+				cells[unit][index] = y * LENGTH<3> + x;
+			}
+		}
+	}
+
+	unsigned int cells[NUM_UNITS<3>][LENGTH<3>];
+};
+
+void SolveLockstep(Grid<3>* grids, size_t count, LockstepResult* results)
+{
+	const unsigned int NUM_CELLS = LENGTH<3> * LENGTH<3>;
+	static const UnitTable units;
+
+	//	Interleave the puzzles: one vector per cell, with lane i holding puzzle i's candidates.  Unused lanes are empty puzzles.
+	uint16_t lanes[LOCKSTEP_LANES];
+	LaneVector cells[NUM_CELLS];
+	for (unsigned int cell = 0; cell < NUM_CELLS; ++cell)
+	{
+		for (unsigned int lane = 0; lane < LOCKSTEP_LANES; ++lane)
+		{
+			unsigned int value = (lane < count) ? grids[lane][cell / LENGTH<3>][cell % LENGTH<3>] : 0;
+			lanes[lane] = (value != 0) ? ValueToMask<3>(value) : ALL_CANDIDATES<3>;
+		}
+		cells[cell] = LoadLanes(lanes);
+	}
+
+	//	All ones in the lanes that have hit a contradiction.  Those lanes keep running with the rest; their masks only shrink.
+	LaneVector dead = Broadcast(0);
+	const LaneVector all = Broadcast(ALL_CANDIDATES<3>);
+
+	bool changed = true;
+	while (changed)
+	{
+		LaneVector delta = Broadcast(0);
+
+		for (unsigned int unit = 0; unit < NUM_UNITS<3>; ++unit)
+		{
+			const unsigned int* unitCells = units.cells[unit];
+			LaneVector masks[LENGTH<3>];
+			LaneVector singles[LENGTH<3>];
+
+			//	Naked singles: remove every solved value from the unit's other cells.  A value solved twice is a contradiction.
+			LaneVector solved = Broadcast(0);
+			LaneVector solvedTwice = Broadcast(0);
+			for (unsigned int i = 0; i < LENGTH<3>; ++i)
+			{
+				masks[i] = cells[unitCells[i]];
+				singles[i] = GetSingles(masks[i]);
+				solvedTwice = Or(solvedTwice, And(solved, singles[i]));
+				solved = Or(solved, singles[i]);
+			}
+			dead = Or(dead, NonZeroLanes(solvedTwice));
+
+			for (unsigned int i = 0; i < LENGTH<3>; ++i)
+			{
+				masks[i] = AndNot(masks[i], AndNot(solved, singles[i]));
+			}
+
+			//	Hidden singles: a value that only one cell can hold goes there.  A value no cell can hold is a contradiction.
+			LaneVector seen = Broadcast(0);
+			LaneVector seenTwice = Broadcast(0);
+			for (unsigned int i = 0; i < LENGTH<3>; ++i)
+			{
+				seenTwice = Or(seenTwice, And(seen, masks[i]));
+				seen = Or(seen, masks[i]);
+			}
+			dead = Or(dead, NonZeroLanes(Xor(seen, all)));
+
+			LaneVector unique = AndNot(seen, seenTwice);
+			for (unsigned int i = 0; i < LENGTH<3>; ++i)
+			{
+				//	Two hidden singles in one cell is also a contradiction.
+				LaneVector hidden = And(masks[i], unique);
+				dead = Or(dead, NonZeroLanes(And(hidden, Decrement(hidden))));
+
+				LaneVector none = EqualsZero(hidden);
+				LaneVector updated = Or(And(none, masks[i]), AndNot(hidden, none));
+				dead = Or(dead, EqualsZero(updated));
+
+				delta = Or(delta, Xor(updated, cells[unitCells[i]]));
+				cells[unitCells[i]] = updated;
+			}
+		}
+
+		changed = !IsZero(delta);
+	}
+
+	//	Split the lanes back out into puzzles.
+	uint16_t deadLanes[LOCKSTEP_LANES];
+	StoreLanes(deadLanes, dead);
+
+	uint16_t masks[NUM_CELLS][LOCKSTEP_LANES];
+	for (unsigned int cell = 0; cell < NUM_CELLS; ++cell)
+	{
+		StoreLanes(masks[cell], cells[cell]);
+	}
+
+	for (unsigned int lane = 0; lane < count; ++lane)
+	{
+		if (deadLanes[lane] != 0)
+		{
+			results[lane] = UnsolvableByPropagation;
+			continue;
+		}
+
+		bool complete = true;
+		for (unsigned int cell = 0; cell < NUM_CELLS && complete; ++cell)
+		{
+			complete = (CountCandidates(masks[cell][lane]) == 1);
+		}
+		if (!complete)
+		{
+			results[lane] = NeedsSearch;
+			continue;
+		}
+
+		for (unsigned int cell = 0; cell < NUM_CELLS; ++cell)
+		{
+			grids[lane][cell / LENGTH<3>][cell % LENGTH<3>] = LowestCandidate(masks[cell][lane]);
+		}
+		results[lane] = SolvedByPropagation;
+	}
+}
\ No newline at end of file
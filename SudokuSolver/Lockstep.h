@@ -0,0 +1,31 @@
+#ifndef LOCKSTEP_H
+#define LOCKSTEP_H
+#pragma once
+
+#include <cstddef>	//	for size_t
+#include "Constants.h"
+#include "Solver.h"
+
+//	Number of 9x9 puzzles propagated side by side: one per 16-bit lane of the widest vector register available.
+//		AVX2 holds 16 candidate masks per register; SSE2 (and the plain C++ fallback) holds 8.
+#if defined(__AVX2__)
+const unsigned int LOCKSTEP_LANES = 16;
+#else
+const unsigned int LOCKSTEP_LANES = 8;
+#endif
+
+//	What propagation alone made of a puzzle.  Kept apart from SolveResult, since needing a guess isn't running out of budget.
+enum LockstepResult
+{
+	SolvedByPropagation,		//	Propagation finished the puzzle, which is filled in.
+	UnsolvableByPropagation,	//	Propagation found a contradiction.
+	NeedsSearch					//	The puzzle needs guessing.
+};
+
+//	Interface functions
+//		Propagates up to LOCKSTEP_LANES 9x9 puzzles at once, one per vector lane, using naked and hidden singles, and
+//		reports each lane's result.  Only solved grids are changed.
+//		NOTE: every given must be in 1, ..., 9; ParsePuzzle() guarantees this.
+void SolveLockstep(Grid<3>* grids, size_t count, LockstepResult* results);
+
+#endif	//	LOCKSTEP_H
\ No newline at end of file
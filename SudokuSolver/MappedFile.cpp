@@ -0,0 +1,146 @@
+#include "MappedFile.h"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>	//	for CreateFileMapping, MapViewOfFile
+#else
+#include <fcntl.h>		//	for open
+#include <sys/mman.h>	//	for mmap, madvise
+#include <sys/stat.h>	//	for fstat
+#include <unistd.h>		//	for close
+#endif
+
+#if defined(_WIN32)
+
+MappedFile::MappedFile() : _data(nullptr), _size(0), _file(INVALID_HANDLE_VALUE), _mapping(nullptr)
+{
+}
+
+bool MappedFile::Open(const char* path)
+{
+	Close();
+
+	_file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (_file == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(_file, &size))
+	{
+		Close();
+		return false;
+	}
+
+	//	Windows can't map an empty file, but there's nothing to read anyway.
+	_size = static_cast<size_t>(size.QuadPart);
+	if (_size == 0)
+	{
+		return true;
+	}
+
+	_mapping = CreateFileMappingA(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (_mapping == nullptr)
+	{
+		Close();
+		return false;
+	}
+
+	_data = static_cast<const char*>(MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+	if (_data == nullptr)
+	{
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (_data != nullptr)
+	{
+		UnmapViewOfFile(_data);
+	}
+	if (_mapping != nullptr)
+	{
+		CloseHandle(_mapping);
+	}
+	if (_file != INVALID_HANDLE_VALUE)
+	{
+		CloseHandle(_file);
+	}
+
+	_data = nullptr;
+	_size = 0;
+	_file = INVALID_HANDLE_VALUE;
+	_mapping = nullptr;
+}
+
+#else
+
+MappedFile::MappedFile() : _data(nullptr), _size(0), _file(-1)
+{
+}
+
+bool MappedFile::Open(const char* path)
+{
+	Close();
+
+	_file = open(path, O_RDONLY);
+	if (_file < 0)
+	{
+		return false;
+	}
+
+	struct stat info;
+	if (fstat(_file, &info) != 0)
+	{
+		Close();
+		return false;
+	}
+
+	//	mmap() rejects zero-length mappings, but there's nothing to read anyway.
+	_size = static_cast<size_t>(info.st_size);
+	if (_size == 0)
+	{
+		return true;
+	}
+
+	void* data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, _file, 0);
+	if (data == MAP_FAILED)
+	{
+		Close();
+		return false;
+	}
+
+	//	Puzzles are read front to back, so ask the kernel to read ahead aggressively.
+	madvise(data, _size, MADV_SEQUENTIAL);
+	_data = static_cast<const char*>(data);
+
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (_data != nullptr)
+	{
+		munmap(const_cast<char*>(_data), _size);
+	}
+	if (_file >= 0)
+	{
+		close(_file);
+	}
+
+	_data = nullptr;
+	_size = 0;
+	_file = -1;
+}
+
+#endif
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
\ No newline at end of file
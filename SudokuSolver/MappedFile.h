@@ -0,0 +1,43 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+#pragma once
+
+#include <cstddef>	//	for size_t
+
+//-------------------------------------------------------------
+//	MappedFile class maps a file read-only into memory, so its contents can be parsed in place without copying.
+class MappedFile
+{
+	public:
+		//	Create an empty mapping.  Call Open() to map a file.
+		MappedFile();
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		//	Map the file at path, replacing any current mapping.
+		//	Returns false if the file can't be opened or mapped.  An empty file maps successfully with no data.
+		bool Open(const char* path);
+		//	Release the current mapping, if any.
+		void Close();
+
+		//	Returns the first byte of the file, or nullptr if the mapping is empty.
+		const char* GetData() const { return _data; };
+		//	Returns the number of bytes in the file.
+		size_t GetSize() const { return _size; };
+
+	private:
+		const char* _data;
+		size_t _size;
+
+#if defined(_WIN32)
+		void* _file;
+		void* _mapping;
+#else
+		int _file;
+#endif
+};
+//-------------------------------------------------------------
+
+#endif	//	MAPPEDFILE_H
\ No newline at end of file
@@ -0,0 +1,138 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+#pragma once
+
+#include <atomic>	//	for atomic
+#include <deque>	//	for deque
+#include <mutex>	//	for mutex, lock_guard
+#include <thread>	//	for thread, yield
+#include <algorithm>	//	for max, min
+#include <vector>	//	for vector
+#include "Constants.h"
+#include "Solver.h"
+
+//	Number of subproblems per thread to split the top of the search tree into before the workers start.
+const unsigned int SUBPROBLEMS_PER_THREAD = 4;
+
+//	Guesses a worker claims from the shared node budget at a time, so the budget's counter isn't touched on every guess.
+const unsigned long long NODE_CLAIM_SLICE = 4096;
+
+//-------------------------------------------------------------
+//	An independent piece of the search tree: a propagated copy of the board, plus the cell to branch on and the candidates left to try there.
+template <unsigned int BASE>
+struct Subproblem
+{
+	Grid<BASE> grid;
+	RefLists<BASE> ref;
+	unsigned int x;
+	unsigned int y;
+	CandidateMask<BASE> remaining;
+};
+
+//	SubtreePool class holds one queue of subproblems per worker.
+//		Workers take from the back of their own queue and steal from the front of others'.  A busy worker donates its
+//		shallowest untried subtree whenever a worker is idle and nothing is queued.  Solutions are tallied in one shared count,
+//		and the worker whose solution reaches the limit cancels the rest through a shared flag.
+//		Guesses are drawn from one shared node budget, and the caller's cancel flag is forwarded to the pool's own, so the
+//		caller's limits bound the whole search rather than each subproblem.
+template <unsigned int BASE>
+class SubtreePool
+{
+	public:
+		//	Create a pool that stops once solutionLimit solutions are found (0 to search the whole tree), once nodeBudget
+		//	guesses have been made (0 for no limit), or once externalCancel is set (nullptr if there is none).
+		SubtreePool(unsigned int numWorkers, unsigned long long solutionLimit, unsigned long long nodeBudget, const std::atomic<bool>* externalCancel);
+
+		//	Queue a subproblem for the specified worker.
+		void Push(unsigned int workerID, const Subproblem<BASE>& subproblem);
+		//	Take a subproblem from the worker's own queue, or steal one.  Returns false if every queue is empty.
+		bool Pop(unsigned int workerID, Subproblem<BASE>& subproblem);
+		//	Marks a popped subproblem as fully searched.
+		void Finish() { _pending.fetch_sub(1); };
+
+		//	Returns true if some worker is idle and there's nothing queued for it to steal.
+		bool WantsWork() const { return _idle.load(std::memory_order_relaxed) > 0 && _queued.load(std::memory_order_relaxed) == 0; };
+		//	Split the shallowest untried subtree off the worker's stack and queue it.
+		void Donate(unsigned int workerID, const Grid<BASE>& grid, const RefLists<BASE>* ref, const Trail<BASE>* trail, SearchStack<BASE>* stack);
+
+		//	Count the worker's solution, and cancel everyone else if it reaches the limit.  Only the first solution is kept.
+		void ReportSolution(const Grid<BASE>& grid);
+		//	Record that a worker ran out of budget, and cancel everyone else.
+		void ReportBudgetExhausted();
+		//	Cancel everyone, as out of budget, if the caller has set its cancel flag.
+		void PollExternalCancel();
+
+		//	Returns true if the guesses are drawn from a shared node budget.
+		bool HasNodeBudget() const { return _nodeBudget != 0; };
+		//	Raise a worker's node limit by its next share of the budget.  Returns false if the budget is spent.
+		bool ClaimNodes(unsigned long long& maxNodes);
+
+		//	Returns true once the search is cancelled or every subproblem has been searched.
+		bool IsDone() { PollExternalCancel(); return _cancelled.load() || _pending.load() == 0; };
+
+		//	Record that a worker started or stopped looking for work.
+		void SetIdle(bool idle);
+		const std::atomic<bool>* GetCancelFlag() const { return &_cancelled; };
+		bool HasSolution() const { return _solutions.load() > 0; };
+		unsigned long long GetSolutionCount() const { return _solutions.load(); };
+		bool WasBudgetExhausted() const { return _exhausted.load(); };
+		void CopySolution(Grid<BASE>& grid) const;
+
+	private:
+		//	A worker's queue.  Donations are rare compared to guesses, so a plain lock is cheap enough.
+		struct WorkerQueue
+		{
+			std::mutex lock;
+			std::deque<Subproblem<BASE>> subproblems;
+		};
+
+		std::vector<WorkerQueue> _queues;
+
+		std::atomic<size_t> _pending;		//	Subproblems queued or being searched.
+		std::atomic<size_t> _queued;		//	Subproblems queued and not yet taken.
+		std::atomic<unsigned int> _idle;	//	Workers looking for work.
+
+		std::atomic<bool> _cancelled;
+		std::atomic<unsigned long long> _solutions;
+		const unsigned long long _solutionLimit;
+		std::atomic<bool> _exhausted;
+		Grid<BASE> _solution;
+
+		const unsigned long long _nodeBudget;
+		std::atomic<unsigned long long> _nodesClaimed;
+		const std::atomic<bool>* _externalCancel;
+};
+
+//	A worker's handle on its pool, passed to ContinueSearch() as its donor so it can donate subtrees.
+template <unsigned int BASE>
+struct PoolWorker
+{
+	//	Also how often a busy worker looks at the caller's cancel flag.
+	bool WantsWork() const { pool->PollExternalCancel(); return pool->WantsWork(); };
+	void Donate(const Grid<BASE>& grid, const RefLists<BASE>* ref, const Trail<BASE>* trail, SearchStack<BASE>* stack) { pool->Donate(workerID, grid, ref, trail, stack); };
+
+	SubtreePool<BASE>* pool;
+	unsigned int workerID;
+};
+//-------------------------------------------------------------
+
+//	Interface functions
+//		Solves grid in place using numThreads threads (0 for one per hardware thread).  Same results as SolveSudoku().
+//		CountSolutionsParallel() counts like CountSolutions(), searching subtrees in parallel against one shared count.
+//		limits.maxNodes bounds the guesses of every thread together, and setting limits.cancelled stops every thread.
+template <unsigned int BASE>
+SolveResult SolveSudokuParallel(Grid<BASE>& grid, const SearchLimits& limits, unsigned int numThreads);
+template <unsigned int BASE>
+SolveResult CountSolutionsParallel(const Grid<BASE>& grid, const SearchLimits& limits, unsigned long long limit, unsigned int numThreads, unsigned long long& count);
+
+//	Helper functions
+template <unsigned int BASE>
+SolveResult SearchParallel(Grid<BASE>& grid, const SearchLimits& limits, unsigned long long limit, unsigned int numThreads, unsigned long long& count);
+template <unsigned int BASE>
+unsigned long long SplitTopLevels(const Subproblem<BASE>& root, size_t target, unsigned long long limit, std::vector<Subproblem<BASE>>& subproblems, Grid<BASE>& grid, unsigned long long& nodes);
+template <unsigned int BASE>
+void RunSearchWorker(SubtreePool<BASE>* pool, unsigned int workerID, const SearchLimits* limits);
+
+#include "Parallel.inl"
+
+#endif	//	PARALLEL_H
\ No newline at end of file
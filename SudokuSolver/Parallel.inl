@@ -0,0 +1,399 @@
+//-------------------------------------------------------------
+template <unsigned int BASE>
+SubtreePool<BASE>::SubtreePool(unsigned int numWorkers, unsigned long long solutionLimit, unsigned long long nodeBudget, const std::atomic<bool>* externalCancel) : _queues(numWorkers), _pending(0), _queued(0), _idle(0), _cancelled(false), _solutions(0), _solutionLimit(solutionLimit), _exhausted(false), _nodeBudget(nodeBudget), _nodesClaimed(0), _externalCancel(externalCancel)
+{
+}
+
+template <unsigned int BASE>
+void SubtreePool<BASE>::Push(unsigned int workerID, const Subproblem<BASE>& subproblem)
+{
+	//	Count the subproblem before it becomes visible, so the pool never looks finished while it's queued.
+	_pending.fetch_add(1);
+
+	std::lock_guard<std::mutex> guard(_queues[workerID].lock);
+	_queues[workerID].subproblems.push_back(subproblem);
+	_queued.fetch_add(1);
+}
+
+template <unsigned int BASE>
+bool SubtreePool<BASE>::Pop(unsigned int workerID, Subproblem<BASE>& subproblem)
+{
+	//	Take the most recent subproblem from our own queue...
+	{
+		WorkerQueue& own = _queues[workerID];
+		std::lock_guard<std::mutex> guard(own.lock);
+		if (!own.subproblems.empty())
+		{
+			subproblem = own.subproblems.back();
+			own.subproblems.pop_back();
+			_queued.fetch_sub(1);
+			return true;
+		}
+	}
+
+	//	...otherwise steal the oldest, and usually largest, subproblem from another worker.
+	unsigned int numWorkers = static_cast<unsigned int>(_queues.size());
+	for (unsigned int offset = 1; offset < numWorkers; ++offset)
+	{
+		WorkerQueue& victim = _queues[(workerID + offset) % numWorkers];
+		std::lock_guard<std::mutex> guard(victim.lock);
+		if (!victim.subproblems.empty())
+		{
+			subproblem = victim.subproblems.front();
+			victim.subproblems.pop_front();
+			_queued.fetch_sub(1);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+template <unsigned int BASE>
+void SubtreePool<BASE>::Donate(unsigned int workerID, const Grid<BASE>& grid, const RefLists<BASE>* ref, const Trail<BASE>* trail, SearchStack<BASE>* stack)
+{
+	//	The shallowest frame with untried candidates roots the largest untried subtree.
+	size_t level = 0;
+	while (level < stack->frames.size() && stack->frames[level].remaining == 0)
+	{
+		++level;
+	}
+	if (level == stack->frames.size())
+	{
+		return;
+	}
+
+	SearchFrame<BASE>& frame = stack->frames[level];
+
+	//	Copy the board, then rewind the copy to the state it was in when that frame was pushed.
+	Subproblem<BASE> subproblem;
+	subproblem.grid = grid;
+	subproblem.ref = *ref;
+
+	Trail<BASE> rewind(trail->begin() + frame.mark, trail->end());
+	UndoTrail(subproblem.grid, &subproblem.ref, &rewind, 0);
+
+	//	Hand over every untried candidate at that level.
+	subproblem.x = frame.x;
+	subproblem.y = frame.y;
+	subproblem.remaining = frame.remaining;
+	frame.remaining = 0;
+
+	Push(workerID, subproblem);
+}
+
+template <unsigned int BASE>
+void SubtreePool<BASE>::ReportSolution(const Grid<BASE>& grid)
+{
+	unsigned long long found = _solutions.fetch_add(1) + 1;
+	if (found == 1)
+	{
+		_solution = grid;
+	}
+
+	if (_solutionLimit != 0 && found >= _solutionLimit)
+	{
+		_cancelled.store(true);
+	}
+}
+
+template <unsigned int BASE>
+void SubtreePool<BASE>::ReportBudgetExhausted()
+{
+	_exhausted.store(true);
+	_cancelled.store(true);
+}
+
+template <unsigned int BASE>
+void SubtreePool<BASE>::PollExternalCancel()
+{
+	if (_externalCancel != nullptr && _externalCancel->load(std::memory_order_relaxed) && !_cancelled.load(std::memory_order_relaxed))
+	{
+		ReportBudgetExhausted();
+	}
+}
+
+//	Hands out the budget a slice at a time.  The last slice is cut short, so the claims never add up to more than the budget.
+template <unsigned int BASE>
+bool SubtreePool<BASE>::ClaimNodes(unsigned long long& maxNodes)
+{
+	unsigned long long claimed = _nodesClaimed.fetch_add(NODE_CLAIM_SLICE);
+	if (claimed >= _nodeBudget)
+	{
+		return false;
+	}
+
+	maxNodes += std::min(NODE_CLAIM_SLICE, _nodeBudget - claimed);
+	return true;
+}
+
+template <unsigned int BASE>
+void SubtreePool<BASE>::SetIdle(bool idle)
+{
+	if (idle)
+	{
+		_idle.fetch_add(1);
+	}
+	else
+	{
+		_idle.fetch_sub(1);
+	}
+}
+
+//	NOTE: only valid once every worker has stopped.
+template <unsigned int BASE>
+void SubtreePool<BASE>::CopySolution(Grid<BASE>& grid) const
+{
+	grid = _solution;
+}
+//-------------------------------------------------------------
+
+template <unsigned int BASE>
+SolveResult SolveSudokuParallel(Grid<BASE>& grid, const SearchLimits& limits, unsigned int numThreads)
+{
+	unsigned long long count;
+	return SearchParallel(grid, limits, 1, numThreads, count);
+}
+
+//	Counts the solutions of grid, stopping once limit are found (0 for no limit).
+template <unsigned int BASE>
+SolveResult CountSolutionsParallel(const Grid<BASE>& grid, const SearchLimits& limits, unsigned long long limit, unsigned int numThreads, unsigned long long& count)
+{
+	Grid<BASE> solution = grid;
+	return SearchParallel(solution, limits, limit, numThreads, count);
+}
+
+//	Searches grid in parallel until limit solutions are found (0 for no limit), leaving the first in grid.
+//	Returns Solved if the limit was reached, or the tree was exhausted after finding at least one solution.
+template <unsigned int BASE>
+SolveResult SearchParallel(Grid<BASE>& grid, const SearchLimits& limits, unsigned long long limit, unsigned int numThreads, unsigned long long& count)
+{
+	count = 0;
+
+	Subproblem<BASE> root;
+	root.grid = grid;
+	if (!root.ref.InitLists(root.grid))
+	{
+		return Unsolvable;
+	}
+
+	//	Deduce as much as possible before splitting.
+	Trail<BASE> trail;
+	if (!Propagate(root.grid, &root.ref, &trail))
+	{
+		return Unsolvable;
+	}
+	if (!FindMostConstrainedCell(root.grid, &root.ref, root.x, root.y, root.remaining))
+	{
+		grid = root.grid;
+		count = 1;
+		return Solved;
+	}
+	if (root.remaining == 0)
+	{
+		return Unsolvable;
+	}
+
+	if (numThreads == 0)
+	{
+		numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+	}
+
+	//	Split the top of the tree into independent subproblems, and deal them out round-robin.
+	//	Solutions that turn up during the split count towards the limit.
+	std::vector<Subproblem<BASE>> subproblems;
+	unsigned long long splitNodes = 0;
+	count = SplitTopLevels(root, numThreads * SUBPROBLEMS_PER_THREAD, limit, subproblems, grid, splitNodes);
+	if (limit != 0 && count >= limit)
+	{
+		return Solved;
+	}
+	if (subproblems.empty())
+	{
+		return (count > 0) ? Solved : Unsolvable;
+	}
+
+	//	The guesses made while splitting come out of the budget too.
+	if (limits.maxNodes != 0 && splitNodes >= limits.maxNodes)
+	{
+		return BudgetExhausted;
+	}
+	unsigned long long nodeBudget = (limits.maxNodes != 0) ? limits.maxNodes - splitNodes : 0;
+
+	SubtreePool<BASE> pool(numThreads, (limit != 0) ? limit - count : 0, nodeBudget, limits.cancelled);
+	for (size_t i = 0; i < subproblems.size(); ++i)
+	{
+		pool.Push(static_cast<unsigned int>(i % numThreads), subproblems[i]);
+	}
+
+	std::vector<std::thread> workers;
+	for (unsigned int workerID = 0; workerID < numThreads; ++workerID)
+	{
+		workers.push_back(std::thread(RunSearchWorker<BASE>, &pool, workerID, &limits));
+	}
+	for (unsigned int workerID = 0; workerID < numThreads; ++workerID)
+	{
+		workers[workerID].join();
+	}
+
+	if (count == 0 && pool.HasSolution())
+	{
+		pool.CopySolution(grid);
+	}
+
+	//	Workers that find solutions at the same moment may overshoot the limit.
+	count += pool.GetSolutionCount();
+	if (limit != 0 && count >= limit)
+	{
+		count = limit;
+		return Solved;
+	}
+
+	if (pool.WasBudgetExhausted())
+	{
+		return BudgetExhausted;
+	}
+
+	return (count > 0) ? Solved : Unsolvable;
+}
+
+//	Expands the tree breadth-first from root until there are at least target subproblems or the tree runs out.
+//	Returns the number of solutions that turned up during the split, leaving the first in grid, and counts the guesses made
+//	in nodes.  Stops early once limit are found.
+template <unsigned int BASE>
+unsigned long long SplitTopLevels(const Subproblem<BASE>& root, size_t target, unsigned long long limit, std::vector<Subproblem<BASE>>& subproblems, Grid<BASE>& grid, unsigned long long& nodes)
+{
+	unsigned long long found = 0;
+
+	std::deque<Subproblem<BASE>> frontier;
+	frontier.push_back(root);
+
+	Trail<BASE> trail;
+	while (!frontier.empty() && frontier.size() < target)
+	{
+		Subproblem<BASE> parent = frontier.front();
+		frontier.pop_front();
+
+		//	Each candidate of the parent's branching cell becomes its own subproblem.
+		CandidateMask<BASE> remaining = parent.remaining;
+		while (remaining != 0)
+		{
+			unsigned int value = LowestCandidate(remaining);
+			remaining &= remaining - 1;
+
+			Subproblem<BASE> child = parent;
+			trail.clear();
+			PlaceValue(child.grid, &child.ref, &trail, parent.x, parent.y, value);
+			++nodes;
+
+			if (!Propagate(child.grid, &child.ref, &trail))
+			{
+				continue;
+			}
+
+			if (!FindMostConstrainedCell(child.grid, &child.ref, child.x, child.y, child.remaining))
+			{
+				if (found++ == 0)
+				{
+					grid = child.grid;
+				}
+				if (limit != 0 && found >= limit)
+				{
+					return found;
+				}
+				continue;
+			}
+
+			if (child.remaining != 0)
+			{
+				frontier.push_back(child);
+			}
+		}
+	}
+
+	subproblems.assign(frontier.begin(), frontier.end());
+	return found;
+}
+
+//	Searches subproblems from the pool until enough solutions are found, the budget runs out, or the tree is exhausted.
+template <unsigned int BASE>
+void RunSearchWorker(SubtreePool<BASE>* pool, unsigned int workerID, const SearchLimits* limits)
+{
+	SearchLimits workerLimits = *limits;
+	workerLimits.cancelled = pool->GetCancelFlag();
+
+	PoolWorker<BASE> worker = { pool, workerID };
+	Subproblem<BASE> subproblem;
+
+	Trail<BASE> trail;
+	trail.reserve(LENGTH<BASE> * LENGTH<BASE>);
+	SearchStack<BASE> stack;
+	stack.frames.reserve(LENGTH<BASE> * LENGTH<BASE>);
+
+	//	The node count runs on from one subproblem to the next, so what's left of a claimed slice isn't lost.
+	stack.nodes = 0;
+	workerLimits.maxNodes = 0;
+
+	bool idle = false;
+	while (!pool->IsDone())
+	{
+		if (!pool->Pop(workerID, subproblem))
+		{
+			//	Let busy workers know there's someone to donate to.
+			if (!idle)
+			{
+				pool->SetIdle(true);
+				idle = true;
+			}
+			std::this_thread::yield();
+			continue;
+		}
+
+		if (idle)
+		{
+			pool->SetIdle(false);
+			idle = false;
+		}
+
+		trail.clear();
+		stack.frames.clear();
+
+		SearchFrame<BASE> root = { subproblem.x, subproblem.y, subproblem.remaining, 0 };
+		stack.frames.push_back(root);
+
+		//	Keep resuming after each solution; once the pool has enough, the cancel flag ends the search.
+		//	When this worker's share of the node budget runs out, it claims another slice and resumes where it stopped.
+		//	The guess that tripped the limit wasn't made, so it's taken back off the count.
+		SolveResult result = BudgetExhausted;
+		bool budgetLeft = !pool->HasNodeBudget() || stack.nodes < workerLimits.maxNodes || pool->ClaimNodes(workerLimits.maxNodes);
+		while (budgetLeft)
+		{
+			result = ContinueSearch(subproblem.grid, &subproblem.ref, &trail, &stack, workerLimits, &worker);
+			if (result == Solved)
+			{
+				pool->ReportSolution(subproblem.grid);
+			}
+			else if (result == BudgetExhausted && pool->HasNodeBudget() && stack.nodes > workerLimits.maxNodes)
+			{
+				--stack.nodes;
+				budgetLeft = pool->ClaimNodes(workerLimits.maxNodes);
+			}
+			else
+			{
+				break;
+			}
+		}
+
+		if (result == BudgetExhausted && !workerLimits.cancelled->load())
+		{
+			pool->ReportBudgetExhausted();
+		}
+
+		pool->Finish();
+	}
+
+	if (idle)
+	{
+		pool->SetIdle(false);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,175 @@
+#include <cstdint>	//	for uint8_t, uint64_t
+#include <mutex>	//	for lock_guard, mutex
+#include "Constants.h"
+#include "Solver.h"
+#include "Canonical.h"
+#include "PuzzleCache.h"
+
+using namespace std;
+
+PuzzleCache::PuzzleCache(size_t capacity) : _numSets((capacity + CACHE_SHARDS * CACHE_WAYS - 1) / (CACHE_SHARDS * CACHE_WAYS))
+{
+	for (unsigned int i = 0; i < CACHE_SHARDS; ++i)
+	{
+		Entry empty = {};
+		_shards[i].entries.assign(_numSets * CACHE_WAYS, empty);
+		_shards[i].nextVictim = 0;
+	}
+}
+
+bool PuzzleCache::Find(const Grid<3>& canonical, SolveResult& result, Grid<3>& solution)
+{
+	if (!IsEnabled())
+	{
+		return false;
+	}
+
+	uint64_t hash = Hash(canonical);
+	Shard& shard = _shards[hash % CACHE_SHARDS];
+	lock_guard<mutex> guard(shard.lock);
+
+	Entry* set = GetSet(shard, hash);
+	for (unsigned int way = 0; way < CACHE_WAYS; ++way)
+	{
+		if (!Matches(set[way], hash, canonical))
+		{
+			continue;
+		}
+
+		result = set[way].result;
+		if (result == Solved)
+		{
+			for (unsigned int cell = 0; cell < LENGTH<3> * LENGTH<3>; ++cell)
+			{
+				//  NOTE: Intentional integer division
+				solution[cell / LENGTH<3>][cell % LENGTH<3>] = set[way].solution[cell];
+			}
+		}
+		return true;
+	}
+
+	return false;
+}
+
+void PuzzleCache::Insert(const Grid<3>& canonical, SolveResult result, const Grid<3>& solution)
+{
+	if (!IsEnabled() || result == BudgetExhausted)
+	{
+		return;
+	}
+
+	uint64_t hash = Hash(canonical);
+	Shard& shard = _shards[hash % CACHE_SHARDS];
+	lock_guard<mutex> guard(shard.lock);
+
+	//	Reuse the puzzle's own entry if another thread got there first, otherwise an empty one, otherwise evict.
+	Entry* set = GetSet(shard, hash);
+	Entry* entry = nullptr;
+	for (unsigned int way = 0; way < CACHE_WAYS && entry == nullptr; ++way)
+	{
+		if (Matches(set[way], hash, canonical))
+		{
+			entry = &set[way];
+		}
+	}
+	for (unsigned int way = 0; way < CACHE_WAYS && entry == nullptr; ++way)
+	{
+		if (set[way].hash == 0)
+		{
+			entry = &set[way];
+		}
+	}
+	if (entry == nullptr)
+	{
+		entry = &set[shard.nextVictim];
+		shard.nextVictim = (shard.nextVictim + 1) % CACHE_WAYS;
+	}
+
+	entry->hash = hash;
+	entry->result = result;
+	for (unsigned int cell = 0; cell < LENGTH<3> * LENGTH<3>; ++cell)
+	{
+		//  NOTE: Intentional integer division
+		entry->puzzle[cell] = static_cast<uint8_t>(canonical[cell / LENGTH<3>][cell % LENGTH<3>]);
+		entry->solution[cell] = static_cast<uint8_t>((result == Solved) ? solution[cell / LENGTH<3>][cell % LENGTH<3>] : 0);
+	}
+}
+
+//	FNV-1a over the cell values.  Never returns 0, which marks an empty entry.
+uint64_t PuzzleCache::Hash(const Grid<3>& canonical)
+{
+	uint64_t hash = 14695981039346656037ull;
+	for (unsigned int y = 0; y < LENGTH<3>; ++y)
+	{
+		for (unsigned int x = 0; x < LENGTH<3>; ++x)
+		{
+			hash = (hash ^ canonical[y][x]) * 1099511628211ull;
+		}
+	}
+
+	return hash | 1;
+}
+
+//	Returns true if entry holds this puzzle.  The hash is compared first, so the cells are only read on a likely match.
+bool PuzzleCache::Matches(const Entry& entry, uint64_t hash, const Grid<3>& canonical)
+{
+	if (entry.hash != hash)
+	{
+		return false;
+	}
+
+	for (unsigned int cell = 0; cell < LENGTH<3> * LENGTH<3>; ++cell)
+	{
+		//  NOTE: Intentional integer division
+		if (entry.puzzle[cell] != canonical[cell / LENGTH<3>][cell % LENGTH<3>])
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+SolveResult SolveSudoku(Grid<3>& grid, const SearchLimits& limits, SolverBackend backend, PuzzleCache& cache)
+{
+	if (!cache.IsEnabled())
+	{
+		return SolveSudoku(grid, limits, backend);
+	}
+
+	//	Canonicalize() relabels values through a table indexed by value, so a given out of range is turned away here, as
+	//	SolveSudoku() would turn it away, before it can index past the end.
+	for (unsigned int cell = 0; cell < LENGTH<3> * LENGTH<3>; ++cell)
+	{
+		//  NOTE: Intentional integer division
+		if (grid[cell / LENGTH<3>][cell % LENGTH<3>] > MAX_VALUE<3>)
+		{
+			return Unsolvable;
+		}
+	}
+
+	Grid<3> canonical;
+	SymmetryTransform transform;
+	Canonicalize(grid, canonical, transform);
+
+	SolveResult result;
+	Grid<3> solution;
+	if (cache.Find(canonical, result, solution))
+	{
+		if (result == Solved)
+		{
+			InvertTransform(transform, solution, grid);
+		}
+		return result;
+	}
+
+	//	Search the caller's grid rather than the canonical one, so a miss finds exactly the solution SolveSudoku() would.
+	result = SolveSudoku(grid, limits, backend);
+	if (result == Solved)
+	{
+		ApplyTransform(transform, grid, solution);
+	}
+	cache.Insert(canonical, result, solution);
+
+	return result;
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+#ifndef PUZZLECACHE_H
+#define PUZZLECACHE_H
+#pragma once
+
+#include <cstddef>	//	for size_t
+#include <cstdint>	//	for uint8_t, uint64_t
+#include <mutex>	//	for mutex
+#include <vector>	//	for vector
+#include "Constants.h"
+#include "Solver.h"
+
+//	Number of independently locked shards, so threads working on different puzzles rarely wait for each other.
+const unsigned int CACHE_SHARDS = 64;
+//	Number of entries a puzzle may occupy within its shard.  When all of them are taken, one is evicted.
+const unsigned int CACHE_WAYS = 4;
+
+//-------------------------------------------------------------
+//	PuzzleCache class remembers the results of 9x9 puzzles in canonical form (see Canonicalize()), so that any
+//	relabelled, transposed, or permuted copy of a puzzle already seen can reuse its solution instead of searching again.
+//		Its size is fixed when it's created; once full, new results replace old ones.  Every method is safe to call from any thread.
+class PuzzleCache
+{
+	public:
+		//	Create a cache holding up to capacity results, rounded up to fill every shard.  A capacity of 0 disables the cache.
+		explicit PuzzleCache(size_t capacity);
+
+		PuzzleCache(const PuzzleCache&) = delete;
+		PuzzleCache& operator=(const PuzzleCache&) = delete;
+
+		//	Returns true unless the cache was created with no capacity.
+		bool IsEnabled() const { return _numSets != 0; };
+
+		//	Look up a canonical puzzle.  Returns false if it isn't cached; otherwise sets result, and the solution if it was Solved.
+		bool Find(const Grid<3>& canonical, SolveResult& result, Grid<3>& solution);
+		//	Record the result of a canonical puzzle, and its solution (in canonical orientation) if it was Solved.
+		//	NOTE: BudgetExhausted results depend on the limits of one search, so they're never cached.
+		void Insert(const Grid<3>& canonical, SolveResult result, const Grid<3>& solution);
+
+	private:
+		struct Entry
+		{
+			uint64_t hash;								//	0 for an empty entry.
+			SolveResult result;
+			uint8_t puzzle[LENGTH<3> * LENGTH<3>];
+			uint8_t solution[LENGTH<3> * LENGTH<3>];
+		};
+
+		struct Shard
+		{
+			std::mutex lock;
+			std::vector<Entry> entries;					//	CACHE_WAYS consecutive entries per set.
+			unsigned int nextVictim;					//	Way to evict next when a set is full.
+		};
+
+		static uint64_t Hash(const Grid<3>& canonical);
+		static bool Matches(const Entry& entry, uint64_t hash, const Grid<3>& canonical);
+
+		Entry* GetSet(Shard& shard, uint64_t hash) { return &shard.entries[((hash / CACHE_SHARDS) % _numSets) * CACHE_WAYS]; };
+
+		Shard _shards[CACHE_SHARDS];
+		size_t _numSets;								//	Sets per shard.
+};
+//-------------------------------------------------------------
+
+//	Interface functions
+//		Solves grid as SolveSudoku() does, but checks cache first: a puzzle equivalent to one already solved takes its solution,
+//		mapped back onto grid's orientation.  Otherwise the puzzle is searched, and the result is cached for its equivalents.
+//		If the cache is disabled this is simply SolveSudoku().
+SolveResult SolveSudoku(Grid<3>& grid, const SearchLimits& limits, SolverBackend backend, PuzzleCache& cache);
+
+#endif	//	PUZZLECACHE_H
\ No newline at end of file
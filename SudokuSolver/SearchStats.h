@@ -0,0 +1,42 @@
+#ifndef SEARCHSTATS_H
+#define SEARCHSTATS_H
+#pragma once
+
+//-------------------------------------------------------------
+//	SearchStats counts the work done by the searches run on one thread.
+//		The counters are only kept when SEARCH_STATS is defined; otherwise COUNT_SEARCH_STAT() compiles to nothing,
+//		so builds without it pay nothing for them.
+struct SearchStats
+{
+	unsigned long long nodes;			//	Guesses made: candidates placed (candidate search) or rows selected (Dancing Links).
+	unsigned long long backtracks;		//	Search levels abandoned once every guess there had been tried.
+	unsigned long long propagations;	//	Passes of the propagation rules (candidate search) or columns covered (Dancing Links).
+};
+
+#if defined(SEARCH_STATS)
+inline thread_local SearchStats threadSearchStats = {};
+#define COUNT_SEARCH_STAT(counter)	(++threadSearchStats.counter)
+#else
+#define COUNT_SEARCH_STAT(counter)	((void)0)
+#endif
+//-------------------------------------------------------------
+
+//	Interface functions
+//		Returns the calling thread's counters since its last reset.  They're always zero unless SEARCH_STATS is defined.
+inline SearchStats GetSearchStats()
+{
+#if defined(SEARCH_STATS)
+	return threadSearchStats;
+#else
+	return SearchStats();
+#endif
+}
+
+inline void ResetSearchStats()
+{
+#if defined(SEARCH_STATS)
+	threadSearchStats = SearchStats();
+#endif
+}
+
+#endif	//	SEARCHSTATS_H
\ No newline at end of file
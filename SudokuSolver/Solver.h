@@ -0,0 +1,227 @@
+#ifndef SOLVER_H
+#define SOLVER_H
+#pragma once
+
+#include <vector>	//	for vector
+#include <atomic>	//	for atomic
+#include <chrono>	//	for steady_clock
+#if defined(_MSC_VER)
+#include <intrin.h>	//	for __popcnt, _BitScanForward
+#endif
+#include "Constants.h"
+#include "SearchStats.h"
+
+//-------------------------------------------------------------
+//	Grid holds the value of every cell, 0 for empty, indexed as grid[y][x].
+template <unsigned int BASE>
+struct Grid
+{
+	unsigned int cells[LENGTH<BASE>][LENGTH<BASE>];
+
+	unsigned int* operator[](unsigned int y) { return cells[y]; };
+	const unsigned int* operator[](unsigned int y) const { return cells[y]; };
+};
+//-------------------------------------------------------------
+
+//-------------------------------------------------------------
+//	Cursor class tracks current x, y position on the puzzle grid, and can provide the current square based upon the x and y values.
+template <unsigned int BASE>
+class Cursor
+{
+	public:
+		//	Create a cursor object at the first cell.
+		Cursor() : _x(0), _y(0) {};
+		//	Create a cursor object positioned at the specified column (x) and row (y).
+		Cursor(unsigned int x, unsigned int y) : _x(x), _y(y) {};
+
+		//	Advance the cursor one cell.
+		//	NOTE: cells are ordered left to right, top to bottom, so advancing past the last column will reset x to 0 and advance y.
+		bool Increment();
+
+		//	Returns the ID of the current column (x).
+		unsigned int GetX() const { return _x; };
+		//	Returns the ID of the current row (y).
+		unsigned int GetY() const { return _y; };
+		//	Returns the ID of the current square.
+		unsigned int GetSquare() const;
+
+	private:
+		unsigned int _x;
+		unsigned int _y;
+};
+//-------------------------------------------------------------
+
+//-------------------------------------------------------------
+//	Returns the number of values set in a candidate mask.
+inline unsigned int CountCandidates(unsigned int mask)
+{
+#if defined(_MSC_VER)
+	return __popcnt(mask);
+#else
+	return __builtin_popcount(mask);
+#endif
+}
+
+//	Returns the lowest value set in a (non-empty) candidate mask.
+inline unsigned int LowestCandidate(unsigned int mask)
+{
+#if defined(_MSC_VER)
+	unsigned long index;
+	_BitScanForward(&index, mask);
+	return index + 1;
+#else
+	return __builtin_ctz(mask) + 1;
+#endif
+}
+
+//	Returns the mask bit representing value.
+template <unsigned int BASE>
+inline CandidateMask<BASE> ValueToMask(unsigned int value)
+{
+	//	NOTE: input values are 1, ..., MAX_VALUE, but bits are 0, ..., MAX_VALUE - 1
+	return static_cast<CandidateMask<BASE>>(1u << (value - 1));
+}
+//-------------------------------------------------------------
+
+//-------------------------------------------------------------
+//	Reference Lists, used to quickly tell which values are still available in a particular row, column, or square.
+template <unsigned int BASE>
+class RefLists
+{
+	static_assert(BASE > 0 && MAX_VALUE<BASE> <= 32, "Each cell's candidates must fit in a 32-bit mask.");
+
+public:
+	typedef CandidateMask<BASE> Mask;
+
+	RefLists();
+	bool InitLists(const Grid<BASE>& grid);
+	void AddValue(unsigned int value, const Cursor<BASE>* cursor);
+	void RemoveValue(unsigned int value, const Cursor<BASE>* cursor);
+	bool HasValue(unsigned int value, const Cursor<BASE>* cursor) const;
+	void EliminateCandidates(Mask mask, const Cursor<BASE>* cursor);
+	void RestoreCandidates(Mask mask, const Cursor<BASE>* cursor);
+
+	//	Returns the values that may still be placed at the cursor's cell.
+	Mask GetCandidates(const Cursor<BASE>* cursor) const
+	{
+		return _rowFree[cursor->GetY()] & _colFree[cursor->GetX()] & _sqFree[cursor->GetSquare()] & _cellFree[cursor->GetY()][cursor->GetX()];
+	}
+
+private:
+	Mask _rowFree[LENGTH<BASE>];
+	Mask _colFree[LENGTH<BASE>];
+	Mask _sqFree[LENGTH<BASE>];
+
+	//	Per-cell masks, cleared by eliminations that don't follow from placed values (e.g., locked candidates).
+	Mask _cellFree[LENGTH<BASE>][LENGTH<BASE>];
+};
+//-------------------------------------------------------------
+
+//-------------------------------------------------------------
+//	Trail of changes made to the grid and Reference Lists, so that everything derived after a guess can be undone on backtrack.
+template <unsigned int BASE>
+struct TrailEntry
+{
+	unsigned int x;
+	unsigned int y;
+	unsigned int value;				//	Value placed in the cell, or 0 if this entry records an elimination.
+	CandidateMask<BASE> eliminated;	//	Candidates removed from the cell when value is 0.
+};
+
+template <unsigned int BASE>
+using Trail = std::vector<TrailEntry<BASE>>;
+//-------------------------------------------------------------
+
+//-------------------------------------------------------------
+//	Bounds on how much work a search may do before giving up.
+struct SearchLimits
+{
+	//	Create limits that never stop the search.
+	SearchLimits() : maxNodes(0), deadline(std::chrono::steady_clock::time_point::max()), cancelled(nullptr) {};
+
+	unsigned long long maxNodes;						//	Maximum number of guesses, or 0 for no limit.
+	std::chrono::steady_clock::time_point deadline;		//	Wall-clock time after which the search gives up.
+	const std::atomic<bool>* cancelled;					//	Flag another thread sets to stop the search, or nullptr.
+};
+
+//	One level of the explicit search stack: the cell being guessed, its untried candidates, and the trail mark to undo to before each guess.
+template <unsigned int BASE>
+struct SearchFrame
+{
+	unsigned int x;
+	unsigned int y;
+	CandidateMask<BASE> remaining;
+	size_t mark;
+};
+
+//	Explicit search stack, kept outside the search loop so a search can be resumed after a solution or have subtrees split off.
+template <unsigned int BASE>
+struct SearchStack
+{
+	std::vector<SearchFrame<BASE>> frames;
+	unsigned long long nodes;			//	Guesses made so far, checked against SearchLimits::maxNodes.
+};
+
+//	Donor used by single-threaded searches, which never have anyone to share work with.
+//		ContinueSearch() is templated on the donor, so the checks compile away entirely here.
+struct NoDonor
+{
+	bool WantsWork() const { return false; };
+
+	template <unsigned int BASE>
+	void Donate(const Grid<BASE>&, const RefLists<BASE>*, const Trail<BASE>*, SearchStack<BASE>*) {};
+};
+
+//	Candidate order used by the solvers: the lowest untried candidate first.
+//		ContinueSearch() is templated on the order too, so this compiles down to LowestCandidate().
+struct LowestFirst
+{
+	unsigned int NextCandidate(unsigned int remaining) { return LowestCandidate(remaining); };
+};
+//-------------------------------------------------------------
+
+//	Interface functions
+//		SolveSudoku() runs the chosen backend; both give the same results under the same limits.
+template <unsigned int BASE>
+SolveResult SolveSudoku(Grid<BASE>& grid, const SearchLimits& limits, SolverBackend backend = CandidateSearch);
+//		CountSolutions() keeps searching after each solution until limit are found (0 for no limit).  UNIQUENESS_LIMIT checks uniqueness.
+//		Returns Solved if any were found, or BudgetExhausted, with count as a lower bound, if the limits ran out first.
+template <unsigned int BASE>
+SolveResult CountSolutions(const Grid<BASE>& grid, const SearchLimits& limits, unsigned long long limit, unsigned long long& count, SolverBackend backend = CandidateSearch);
+
+//	Search functions
+template <unsigned int BASE>
+SolveResult IterativelySolve(Grid<BASE>& grid, RefLists<BASE>* ref, Trail<BASE>* trail, const SearchLimits& limits);
+template <unsigned int BASE, typename Donor>
+SolveResult ContinueSearch(Grid<BASE>& grid, RefLists<BASE>* ref, Trail<BASE>* trail, SearchStack<BASE>* stack, const SearchLimits& limits, Donor* donor);
+template <unsigned int BASE, typename Donor, typename Order>
+SolveResult ContinueSearch(Grid<BASE>& grid, RefLists<BASE>* ref, Trail<BASE>* trail, SearchStack<BASE>* stack, const SearchLimits& limits, Donor* donor, Order* order);
+template <unsigned int BASE>
+bool FindMostConstrainedCell(const Grid<BASE>& grid, const RefLists<BASE>* ref, unsigned int& cellX, unsigned int& cellY, CandidateMask<BASE>& candidates);
+
+//	Trail functions
+template <unsigned int BASE>
+void PlaceValue(Grid<BASE>& grid, RefLists<BASE>* ref, Trail<BASE>* trail, unsigned int x, unsigned int y, unsigned int value);
+template <unsigned int BASE>
+bool EliminateFromCell(const Grid<BASE>& grid, RefLists<BASE>* ref, Trail<BASE>* trail, unsigned int x, unsigned int y, CandidateMask<BASE> mask);
+template <unsigned int BASE>
+void UndoTrail(Grid<BASE>& grid, RefLists<BASE>* ref, Trail<BASE>* trail, size_t mark);
+
+//	Propagation functions
+//		Propagate() repeatedly applies naked singles, hidden singles, and locked candidates until nothing changes.
+template <unsigned int BASE>
+void GetUnitCell(unsigned int unit, unsigned int index, unsigned int& x, unsigned int& y);
+template <unsigned int BASE>
+bool Propagate(Grid<BASE>& grid, RefLists<BASE>* ref, Trail<BASE>* trail);
+template <unsigned int BASE>
+bool ApplyNakedSingles(Grid<BASE>& grid, RefLists<BASE>* ref, Trail<BASE>* trail, bool& changed);
+template <unsigned int BASE>
+bool ApplyHiddenSingles(Grid<BASE>& grid, RefLists<BASE>* ref, Trail<BASE>* trail, bool& changed);
+template <unsigned int BASE>
+void ApplyLockedCandidates(const Grid<BASE>& grid, RefLists<BASE>* ref, Trail<BASE>* trail, bool& changed);
+
+//	NOTE: Everything above is templated on BASE, so the definitions must be visible wherever they're used.
+#include "DancingLinks.h"
+#include "Solver.inl"
+
+#endif	//	SOLVER_H
\ No newline at end of file
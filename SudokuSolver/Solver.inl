@@ -0,0 +1,671 @@
+//-------------------------------------------------------------
+template <unsigned int BASE>
+inline bool Cursor<BASE>::Increment()
+{
+	_x += 1;
+	if (_x >= LENGTH<BASE>)
+	{
+		_x = 0;
+		_y += 1;
+		if (_y >= LENGTH<BASE>)
+		{
+			_x = LENGTH<BASE> - 1;
+			_y = LENGTH<BASE> - 1;
+			return false;
+		}
+	}
+	return true;
+}
+
+template <unsigned int BASE>
+inline unsigned int Cursor<BASE>::GetSquare() const {
+	//  NOTE: Intentional integer division
+	unsigned int sqX = _x / BASE;
+	unsigned int sqY = _y / BASE;
+
+	return (sqX + (sqY * BASE));
+}
+//-------------------------------------------------------------
+
+//-------------------------------------------------------------
+template <unsigned int BASE>
+RefLists<BASE>::RefLists()
+{
+	for (unsigned int listID = 0; listID < LENGTH<BASE>; ++listID)
+	{
+		_rowFree[listID] = ALL_CANDIDATES<BASE>;
+		_colFree[listID] = ALL_CANDIDATES<BASE>;
+		_sqFree[listID] = ALL_CANDIDATES<BASE>;
+
+		for (unsigned int elementID = 0; elementID < LENGTH<BASE>; ++elementID)
+		{
+			_cellFree[listID][elementID] = ALL_CANDIDATES<BASE>;
+		}
+	}
+}
+
+//	Adds a value to the specified Reference Lists.
+//	NOTE: value must be in 1, ..., MAX_VALUE; InitLists() rejects puzzles that violate this.
+template <unsigned int BASE>
+void RefLists<BASE>::AddValue(unsigned int value, const Cursor<BASE>* cursor)
+{
+	Mask bit = ValueToMask<BASE>(value);
+	_rowFree[cursor->GetY()] &= ~bit;
+	_colFree[cursor->GetX()] &= ~bit;
+	_sqFree[cursor->GetSquare()] &= ~bit;
+}
+
+//	Removes a value from the specified Reference Lists.
+//	NOTE: value must be in 1, ..., MAX_VALUE; InitLists() rejects puzzles that violate this.
+template <unsigned int BASE>
+void RefLists<BASE>::RemoveValue(unsigned int value, const Cursor<BASE>* cursor)
+{
+	Mask bit = ValueToMask<BASE>(value);
+	_rowFree[cursor->GetY()] |= bit;
+	_colFree[cursor->GetX()] |= bit;
+	_sqFree[cursor->GetSquare()] |= bit;
+}
+
+//	Return true if value is already in one of the specified Reference Lists, false if it is thus far unique.
+template <unsigned int BASE>
+bool RefLists<BASE>::HasValue(unsigned int value, const Cursor<BASE>* cursor) const
+{
+	return ((_rowFree[cursor->GetY()] & _colFree[cursor->GetX()] & _sqFree[cursor->GetSquare()]) & ValueToMask<BASE>(value)) == 0;
+}
+
+//	Removes the specified candidates from the cursor's cell only.
+template <unsigned int BASE>
+void RefLists<BASE>::EliminateCandidates(Mask mask, const Cursor<BASE>* cursor)
+{
+	_cellFree[cursor->GetY()][cursor->GetX()] &= ~mask;
+}
+
+//	Returns previously eliminated candidates to the cursor's cell.
+template <unsigned int BASE>
+void RefLists<BASE>::RestoreCandidates(Mask mask, const Cursor<BASE>* cursor)
+{
+	_cellFree[cursor->GetY()][cursor->GetX()] |= mask;
+}
+
+//	Fills the Reference Lists with the puzzle's initial state.
+//	Returns false if a value is out of range or repeated within a row, column, or square.
+template <unsigned int BASE>
+bool RefLists<BASE>::InitLists(const Grid<BASE>& grid)
+{
+	Cursor<BASE> cursor;
+	unsigned int curVal;
+
+	do
+	{
+		curVal = grid[cursor.GetY()][cursor.GetX()];
+
+		if (curVal != 0)
+		{
+			if (curVal <= MAX_VALUE<BASE> && !HasValue(curVal, &cursor))
+			{
+				AddValue(curVal, &cursor);
+			}
+			else
+			{
+				return false;
+			}
+		}
+		
+	} while (cursor.Increment());
+
+	return true;
+}
+//-------------------------------------------------------------
+
+//-------------------------------------------------------------
+//	Places value in the grid and Reference Lists, recording it on the trail.
+template <unsigned int BASE>
+void PlaceValue(Grid<BASE>& grid, RefLists<BASE>* ref, Trail<BASE>* trail, unsigned int x, unsigned int y, unsigned int value)
+{
+	Cursor<BASE> cursor(x, y);
+	grid[y][x] = value;
+	ref->AddValue(value, &cursor);
+
+	TrailEntry<BASE> entry = { x, y, value, 0 };
+	trail->push_back(entry);
+}
+
+//	Removes candidates from an empty cell, recording the removal on the trail.
+//	Returns true if any candidate was actually removed.
+template <unsigned int BASE>
+bool EliminateFromCell(const Grid<BASE>& grid, RefLists<BASE>* ref, Trail<BASE>* trail, unsigned int x, unsigned int y, CandidateMask<BASE> mask)
+{
+	if (grid[y][x] != 0)
+	{
+		return false;
+	}
+
+	Cursor<BASE> cursor(x, y);
+	CandidateMask<BASE> removed = ref->GetCandidates(&cursor) & mask;
+	if (removed == 0)
+	{
+		return false;
+	}
+
+	ref->EliminateCandidates(removed, &cursor);
+
+	TrailEntry<BASE> entry = { x, y, 0, removed };
+	trail->push_back(entry);
+	return true;
+}
+
+//	Reverts every change recorded on the trail after mark, newest first.
+template <unsigned int BASE>
+void UndoTrail(Grid<BASE>& grid, RefLists<BASE>* ref, Trail<BASE>* trail, size_t mark)
+{
+	while (trail->size() > mark)
+	{
+		const TrailEntry<BASE>& entry = trail->back();
+		Cursor<BASE> cursor(entry.x, entry.y);
+
+		if (entry.value != 0)
+		{
+			ref->RemoveValue(entry.value, &cursor);
+			grid[entry.y][entry.x] = 0;
+		}
+		else
+		{
+			ref->RestoreCandidates(entry.eliminated, &cursor);
+		}
+
+		trail->pop_back();
+	}
+}
+//-------------------------------------------------------------
+
+//-------------------------------------------------------------
+//	Returns the position of the index-th cell of a unit.
+template <unsigned int BASE>
+void GetUnitCell(unsigned int unit, unsigned int index, unsigned int& x, unsigned int& y)
+{
+	if (unit < LENGTH<BASE>)
+	{
+		x = index;
+		y = unit;
+	}
+	else if (unit < 2 * LENGTH<BASE>)
+	{
+		x = unit - LENGTH<BASE>;
+		y = index;
+	}
+	else
+	{
+		//  NOTE: Intentional integer division
+		unsigned int square = unit - 2 * LENGTH<BASE>;
+		x = (square % BASE) * BASE + (index % BASE);
+		y = (square / BASE) * BASE + (index / BASE);
+	}
+}
+
+//	Returns false if a contradiction is found, true otherwise.  All changes are recorded on the trail.
+template <unsigned int BASE>
+bool Propagate(Grid<BASE>& grid, RefLists<BASE>* ref, Trail<BASE>* trail)
+{
+	bool changed = true;
+	while (changed)
+	{
+		changed = false;
+		COUNT_SEARCH_STAT(propagations);
+
+		//	Singles are cheap and usually sufficient, so only look for locked candidates once they run dry.
+		if (!ApplyNakedSingles(grid, ref, trail, changed) ||
+			!ApplyHiddenSingles(grid, ref, trail, changed))
+		{
+			return false;
+		}
+
+		if (!changed)
+		{
+			ApplyLockedCandidates(grid, ref, trail, changed);
+		}
+	}
+
+	return true;
+}
+
+//	Fills every empty cell that has exactly one candidate.
+//	Returns false if an empty cell has no candidates.
+template <unsigned int BASE>
+bool ApplyNakedSingles(Grid<BASE>& grid, RefLists<BASE>* ref, Trail<BASE>* trail, bool& changed)
+{
+	Cursor<BASE> cursor;
+
+	do
+	{
+		if (grid[cursor.GetY()][cursor.GetX()] == 0)
+		{
+			CandidateMask<BASE> candidates = ref->GetCandidates(&cursor);
+			if (candidates == 0)
+			{
+				return false;
+			}
+
+			//	If only one bit is set...
+			if ((candidates & (candidates - 1)) == 0)
+			{
+				PlaceValue(grid, ref, trail, cursor.GetX(), cursor.GetY(), LowestCandidate(candidates));
+				changed = true;
+			}
+		}
+	} while (cursor.Increment());
+
+	return true;
+}
+
+//	Fills every cell that is the only place in one of its units for some value.
+//	Returns false if a unit has a value that can't be placed anywhere, or a cell is the only place for two values.
+template <unsigned int BASE>
+bool ApplyHiddenSingles(Grid<BASE>& grid, RefLists<BASE>* ref, Trail<BASE>* trail, bool& changed)
+{
+	unsigned int x;
+	unsigned int y;
+
+	for (unsigned int unit = 0; unit < NUM_UNITS<BASE>; ++unit)
+	{
+		//	Collect the values seen in at least one, and in more than one, empty cell of this unit.
+		CandidateMask<BASE> atLeastOnce = 0;
+		CandidateMask<BASE> moreThanOnce = 0;
+		CandidateMask<BASE> placed = 0;
+
+		for (unsigned int index = 0; index < LENGTH<BASE>; ++index)
+		{
+			GetUnitCell<BASE>(unit, index, x, y);
+			if (grid[y][x] != 0)
+			{
+				placed |= ValueToMask<BASE>(grid[y][x]);
+			}
+			else
+			{
+				Cursor<BASE> cursor(x, y);
+				CandidateMask<BASE> candidates = ref->GetCandidates(&cursor);
+				moreThanOnce |= atLeastOnce & candidates;
+				atLeastOnce |= candidates;
+			}
+		}
+
+		//	Every value must be either placed or still possible somewhere in the unit.
+		if ((atLeastOnce | placed) != ALL_CANDIDATES<BASE>)
+		{
+			return false;
+		}
+
+		CandidateMask<BASE> singles = atLeastOnce & ~moreThanOnce;
+		if (singles == 0)
+		{
+			continue;
+		}
+
+		for (unsigned int index = 0; index < LENGTH<BASE> && singles != 0; ++index)
+		{
+			GetUnitCell<BASE>(unit, index, x, y);
+			if (grid[y][x] != 0)
+			{
+				continue;
+			}
+
+			Cursor<BASE> cursor(x, y);
+			CandidateMask<BASE> hidden = ref->GetCandidates(&cursor) & singles;
+			if (hidden != 0)
+			{
+				if ((hidden & (hidden - 1)) != 0)
+				{
+					return false;
+				}
+
+				PlaceValue(grid, ref, trail, x, y, LowestCandidate(hidden));
+				singles &= ~hidden;
+				changed = true;
+			}
+		}
+	}
+
+	return true;
+}
+
+//	Eliminates candidates using square/line interactions:
+//		Pointing - if a value's candidates within a square all lie on one row (or column), remove it from the rest of that line.
+//		Claiming - if a value's candidates within a row (or column) all lie in one square, remove it from the rest of that square.
+template <unsigned int BASE>
+void ApplyLockedCandidates(const Grid<BASE>& grid, RefLists<BASE>* ref, Trail<BASE>* trail, bool& changed)
+{
+	for (unsigned int sqY = 0; sqY < BASE; ++sqY)
+	{
+		for (unsigned int sqX = 0; sqX < BASE; ++sqX)
+		{
+			//	Union of candidates on each row and column segment of this square.
+			CandidateMask<BASE> rowSegment[BASE] = {};
+			CandidateMask<BASE> colSegment[BASE] = {};
+
+			for (unsigned int i = 0; i < BASE; ++i)
+			{
+				for (unsigned int j = 0; j < BASE; ++j)
+				{
+					unsigned int x = sqX * BASE + j;
+					unsigned int y = sqY * BASE + i;
+					if (grid[y][x] == 0)
+					{
+						Cursor<BASE> cursor(x, y);
+						CandidateMask<BASE> candidates = ref->GetCandidates(&cursor);
+						rowSegment[i] |= candidates;
+						colSegment[j] |= candidates;
+					}
+				}
+			}
+
+			for (unsigned int i = 0; i < BASE; ++i)
+			{
+				CandidateMask<BASE> otherRows = 0;
+				CandidateMask<BASE> otherCols = 0;
+				for (unsigned int k = 0; k < BASE; ++k)
+				{
+					if (k != i)
+					{
+						otherRows |= rowSegment[k];
+						otherCols |= colSegment[k];
+					}
+				}
+
+				//	Pointing: values confined to this row (column) segment of the square.
+				CandidateMask<BASE> pointingRow = rowSegment[i] & ~otherRows;
+				CandidateMask<BASE> pointingCol = colSegment[i] & ~otherCols;
+
+				//	Claiming: values on this row (column) that appear in no other square along it.
+				CandidateMask<BASE> outsideRow = 0;
+				CandidateMask<BASE> outsideCol = 0;
+				for (unsigned int k = 0; k < LENGTH<BASE>; ++k)
+				{
+					unsigned int y = sqY * BASE + i;
+					unsigned int x = sqX * BASE + i;
+					if (k / BASE != sqX && grid[y][k] == 0)
+					{
+						Cursor<BASE> cursor(k, y);
+						outsideRow |= ref->GetCandidates(&cursor);
+					}
+					if (k / BASE != sqY && grid[k][x] == 0)
+					{
+						Cursor<BASE> cursor(x, k);
+						outsideCol |= ref->GetCandidates(&cursor);
+					}
+				}
+				CandidateMask<BASE> claimingRow = rowSegment[i] & ~outsideRow;
+				CandidateMask<BASE> claimingCol = colSegment[i] & ~outsideCol;
+
+				//	Apply the eliminations.
+				for (unsigned int k = 0; k < LENGTH<BASE>; ++k)
+				{
+					unsigned int y = sqY * BASE + i;
+					unsigned int x = sqX * BASE + i;
+					if (pointingRow != 0 && k / BASE != sqX)
+					{
+						changed |= EliminateFromCell(grid, ref, trail, k, y, pointingRow);
+					}
+					if (pointingCol != 0 && k / BASE != sqY)
+					{
+						changed |= EliminateFromCell(grid, ref, trail, x, k, pointingCol);
+					}
+				}
+				for (unsigned int k = 0; k < BASE; ++k)
+				{
+					for (unsigned int j = 0; j < BASE; ++j)
+					{
+						if (claimingRow != 0 && k != i)
+						{
+							changed |= EliminateFromCell(grid, ref, trail, sqX * BASE + j, sqY * BASE + k, claimingRow);
+						}
+						if (claimingCol != 0 && k != i)
+						{
+							changed |= EliminateFromCell(grid, ref, trail, sqX * BASE + k, sqY * BASE + j, claimingCol);
+						}
+					}
+				}
+			}
+		}
+	}
+}
+//-------------------------------------------------------------
+
+//	Solves grid in place within the given limits.
+//	If the result is not Solved, grid is left in its initial state.  An invalid initial state is reported as Unsolvable.
+template <unsigned int BASE>
+SolveResult SolveSudoku(Grid<BASE>& grid, const SearchLimits& limits, SolverBackend backend)
+{
+	if (backend == DancingLinksSearch)
+	{
+		return SolveExactCover(grid, limits);
+	}
+
+	RefLists<BASE> reference;
+	if (!reference.InitLists(grid))
+	{
+		return Unsolvable;
+	}
+
+	Trail<BASE> trail;
+	trail.reserve(LENGTH<BASE> * LENGTH<BASE>);
+
+	SolveResult result = IterativelySolve(grid, &reference, &trail, limits);
+	if (result != Solved)
+	{
+		UndoTrail(grid, &reference, &trail, 0);
+	}
+
+	return result;
+}
+
+template <unsigned int BASE>
+SolveResult CountSolutions(const Grid<BASE>& grid, const SearchLimits& limits, unsigned long long limit, unsigned long long& count, SolverBackend backend)
+{
+	if (backend == DancingLinksSearch)
+	{
+		return CountExactCovers(grid, limits, limit, count);
+	}
+
+	count = 0;
+
+	Grid<BASE> board = grid;
+	RefLists<BASE> reference;
+	if (!reference.InitLists(board))
+	{
+		return Unsolvable;
+	}
+
+	Trail<BASE> trail;
+	trail.reserve(LENGTH<BASE> * LENGTH<BASE>);
+
+	unsigned int cellX;
+	unsigned int cellY;
+	CandidateMask<BASE> candidates;
+
+	if (!Propagate(board, &reference, &trail))
+	{
+		return Unsolvable;
+	}
+	if (!FindMostConstrainedCell(board, &reference, cellX, cellY, candidates))
+	{
+		count = 1;
+		return Solved;
+	}
+
+	SearchStack<BASE> stack;
+	stack.nodes = 0;
+	stack.frames.reserve(LENGTH<BASE> * LENGTH<BASE>);
+
+	SearchFrame<BASE> root = { cellX, cellY, candidates, trail.size() };
+	stack.frames.push_back(root);
+
+	//	Each Solved result leaves the stack intact, so the next call picks up where the last solution left off.
+	NoDonor donor;
+	SolveResult result;
+	while ((result = ContinueSearch(board, &reference, &trail, &stack, limits, &donor)) == Solved)
+	{
+		if (++count == limit)
+		{
+			return Solved;
+		}
+	}
+
+	if (result == BudgetExhausted)
+	{
+		return BudgetExhausted;
+	}
+
+	return (count > 0) ? Solved : Unsolvable;
+}
+
+//	Searches without recursion: each guess pushes a frame onto an explicit stack, and backtracking unwinds the trail to that frame's mark.
+template <unsigned int BASE>
+SolveResult IterativelySolve(Grid<BASE>& grid, RefLists<BASE>* ref, Trail<BASE>* trail, const SearchLimits& limits)
+{
+	unsigned int cellX;
+	unsigned int cellY;
+	CandidateMask<BASE> candidates;
+
+	//	Deduce as much as possible before guessing.
+	if (!Propagate(grid, ref, trail))
+	{
+		return Unsolvable;
+	}
+	if (!FindMostConstrainedCell(grid, ref, cellX, cellY, candidates))
+	{
+		return Solved;
+	}
+	if (candidates == 0)
+	{
+		return Unsolvable;
+	}
+
+	SearchStack<BASE> stack;
+	stack.nodes = 0;
+	stack.frames.reserve(LENGTH<BASE> * LENGTH<BASE>);
+
+	SearchFrame<BASE> root = { cellX, cellY, candidates, trail->size() };
+	stack.frames.push_back(root);
+
+	NoDonor donor;
+	return ContinueSearch(grid, ref, trail, &stack, limits, &donor);
+}
+
+//	Runs the search on stack until it finds a solution, exhausts the tree, or runs out of budget.
+//		After a Solved result the stack is left intact, so calling again resumes with the next candidate.
+//		Whenever the donor reports that another worker is idle, an untried subtree is handed to it.
+template <unsigned int BASE, typename Donor>
+SolveResult ContinueSearch(Grid<BASE>& grid, RefLists<BASE>* ref, Trail<BASE>* trail, SearchStack<BASE>* stack, const SearchLimits& limits, Donor* donor)
+{
+	LowestFirst order;
+	return ContinueSearch(grid, ref, trail, stack, limits, donor, &order);
+}
+
+//	As above, trying each cell's candidates in the order's order rather than lowest first.
+template <unsigned int BASE, typename Donor, typename Order>
+SolveResult ContinueSearch(Grid<BASE>& grid, RefLists<BASE>* ref, Trail<BASE>* trail, SearchStack<BASE>* stack, const SearchLimits& limits, Donor* donor, Order* order)
+{
+	unsigned int cellX;
+	unsigned int cellY;
+	CandidateMask<BASE> candidates;
+
+	while (!stack->frames.empty())
+	{
+		SearchFrame<BASE>& frame = stack->frames.back();
+
+		//	Undo the previous guess at this level and everything derived from it.
+		UndoTrail(grid, ref, trail, frame.mark);
+
+		//	If every candidate at this level has failed (or been given away), backtrack.
+		if (frame.remaining == 0)
+		{
+			stack->frames.pop_back();
+			COUNT_SEARCH_STAT(backtracks);
+			continue;
+		}
+
+		//	Stop if we've exceeded the budget or been cancelled.
+		++stack->nodes;
+		COUNT_SEARCH_STAT(nodes);
+		if (limits.maxNodes != 0 && stack->nodes > limits.maxNodes)
+		{
+			return BudgetExhausted;
+		}
+		if (stack->nodes % DEADLINE_CHECK_INTERVAL == 0 && std::chrono::steady_clock::now() >= limits.deadline)
+		{
+			return BudgetExhausted;
+		}
+		if (limits.cancelled != nullptr && limits.cancelled->load(std::memory_order_relaxed))
+		{
+			return BudgetExhausted;
+		}
+
+		//	Share work with idle threads; this may empty the current frame.
+		if (stack->nodes % DONATION_CHECK_INTERVAL == 0 && donor->WantsWork())
+		{
+			donor->Donate(grid, ref, trail, stack);
+			if (frame.remaining == 0)
+			{
+				continue;
+			}
+		}
+
+		//	Guess the next untried candidate, then deduce its consequences.
+		unsigned int value = order->NextCandidate(frame.remaining);
+		frame.remaining &= ~ValueToMask<BASE>(value);
+		PlaceValue(grid, ref, trail, frame.x, frame.y, value);
+
+		if (!Propagate(grid, ref, trail))
+		{
+			continue;
+		}
+
+		//	If no cells are empty, the puzzle is solved.
+		if (!FindMostConstrainedCell(grid, ref, cellX, cellY, candidates))
+		{
+			return Solved;
+		}
+
+		//	Otherwise branch on the empty cell with the fewest candidates.
+		if (candidates != 0)
+		{
+			SearchFrame<BASE> next = { cellX, cellY, candidates, trail->size() };
+			stack->frames.push_back(next);
+		}
+	}
+
+	return Unsolvable;
+}
+
+//	Finds the empty cell with the fewest remaining candidates, returning its position and candidates.
+//	Returns false if there are no empty cells.
+//		NOTE: a returned candidate mask of 0 means the puzzle cannot be completed from this state.
+template <unsigned int BASE>
+bool FindMostConstrainedCell(const Grid<BASE>& grid, const RefLists<BASE>* ref, unsigned int& cellX, unsigned int& cellY, CandidateMask<BASE>& candidates)
+{
+	Cursor<BASE> cursor;
+	unsigned int bestCount = MAX_VALUE<BASE> + 1;
+
+	do
+	{
+		if (grid[cursor.GetY()][cursor.GetX()] == 0)
+		{
+			CandidateMask<BASE> cellCandidates = ref->GetCandidates(&cursor);
+			unsigned int count = CountCandidates(cellCandidates);
+			if (count < bestCount)
+			{
+				bestCount = count;
+				cellX = cursor.GetX();
+				cellY = cursor.GetY();
+				candidates = cellCandidates;
+
+				//	A cell with zero or one candidate can't be beaten.
+				if (count <= 1)
+				{
+					break;
+				}
+			}
+		}
+	} while (cursor.Increment());
+
+	return bestCount <= MAX_VALUE<BASE>;
+}
\ No newline at end of file
@@ -1,205 +1,124 @@
 /*
 	PROBLEM: Given a specified valid Sudoku puzzle, determine a solution.
+
+	USAGE:	source						Solves the built-in puzzle.
+			source -p puzzle			Solves one puzzle, given as a single line, using every core.
+										9x9, 16x16, and 25x25 puzzles are told apart by their length.
+			source -c limit puzzle		Counts the solutions of one puzzle, stopping at limit (0 for all of them), using every core.
+										A limit of 2 checks that the puzzle has exactly one solution.
+			source -g count [clues [difficulty [seed]]]
+										Writes count new 9x9 puzzles with unique solutions to stdout, one per line, using every core.
+										Each is dug down to clues givens (0 for as few as possible), and difficulty may be
+										any, easy, medium, or hard.  The same seed always gives the same puzzles.
+			source input [output]		Solves every puzzle in input, one per line, writing solutions to output (or stdout).
+			source -k entries input [output]
+										As above, but keeps up to entries 9x9 results in a cache keyed by canonical form,
+										so relabelled, transposed, or permuted copies of a puzzle are only searched once.
+			source -t					Runs the self-checks, naming any that fail, and exits with 1 if one does.
+
+			Any of the above may be preceded by -d to use the Dancing Links exact-cover solver instead of candidate search.
+			NOTE: -d -p and -d -c run on a single core, since only candidate search splits a puzzle across threads.
+			NOTE: -g always checks uniqueness with candidate search, so -d has no effect on it.
 */
 
 #include <iostream>	//	for cout
+#include <cstring>	//	for strcmp, strlen
+#include <cstdlib>	//	for strtoul, strtoull
+#include <string>	//	for string
+#include <vector>	//	for vector
+#include "Constants.h"
+#include "Solver.h"
+#include "Batch.h"
+#include "Parallel.h"
+#include "Generator.h"
+#include "PuzzleCache.h"
 
 using namespace std;
 
-//  BASE defines the scope of the puzzle; code works on BASE > 0.  NOTE: Untested on BASE >= 4.
-//      For example, BASE = 3 indicates a puzzle of 3x3.
-const unsigned int BASE = 3;
-
-//	LENGTH defines the number of cells per side of the puzzle.
-//		For example, LENGTH = 9 indicates a puzzle of 9x9 cells.
-const unsigned int LENGTH = BASE * BASE;
-
-//	MAX_VALUE defines the highest value that can be stored in a cell.  Cell values may range from 1, ..., MAX_VALUE.
-const unsigned int MAX_VALUE = LENGTH;
+template <unsigned int BASE>
+int SolveSinglePuzzle(const char* text, SolverBackend backend);
+template <unsigned int BASE>
+int CountPuzzleSolutions(const char* text, unsigned long long limit, SolverBackend backend);
+int GeneratePuzzleLines(int argc, char* argv[]);
+int RunSelfChecks(SolverBackend backend);
+bool CheckCachedInvalidGivens(SolverBackend backend);
+template <unsigned int BASE>
+void OutputResult(SolveResult result, const Grid<BASE>& grid);
+template <unsigned int BASE>
+void OutputSolution(const Grid<BASE>& grid);
+
+int main(int argc, char* argv[]) {
+
+	SolverBackend backend = CandidateSearch;
+	if (argc > 1 && strcmp(argv[1], "-d") == 0)
+	{
+		backend = DancingLinksSearch;
+		--argc;
+		++argv;
+	}
 
-//-------------------------------------------------------------
-//	Cursor class tracks current x, y position on the puzzle grid, and can provide the current square based upon the x and y values.
-class Cursor
-{
-	public:
-		//	Create a cursor object, defining the maximum values for the row (y) and column (x) properties.  Other values initialize to 0.
-		Cursor(unsigned int xMax, unsigned int yMax) : _x(0), _y(0), _maxX(xMax), _maxY(yMax) {};
-		
-		//	Advance the cursor one cell.
-		//	NOTE: cells are ordered left to right, top to bottom, so advancing past xMax will reset x to 0 and advance y.
-		bool Increment();
-
-		//	Returns the ID of the current column (x).
-		unsigned int GetX() const { return _x; };
-		//	Returns the ID of the current row (y).
-		unsigned int GetY() const { return _y; };
-		//	Returns the ID of the current square.
-		unsigned int GetSquare() const;
-
-	private:
-		unsigned int _x;
-		unsigned int _y;
-
-		const unsigned int _maxX;
-		const unsigned int _maxY;
-};
-
-bool Cursor::Increment()
-{
-	_x += 1;
-	if (_x >= _maxX)
+	if (argc > 2 && strcmp(argv[1], "-p") == 0)
 	{
-		_x = 0;
-		_y += 1;
-		if (_y >= _maxY)
+		switch (GetBaseForPuzzleLength(strlen(argv[2])))
 		{
-			_x = _maxX - 1;
-			_y = _maxY - 1;
-			return false;
+			case 3:		return SolveSinglePuzzle<3>(argv[2], backend);
+			case 4:		return SolveSinglePuzzle<4>(argv[2], backend);
+			case 5:		return SolveSinglePuzzle<5>(argv[2], backend);
+			default:
+				cerr << "Puzzles must be " << PUZZLE_CHARS<3> << ", " << PUZZLE_CHARS<4> << ", or " << PUZZLE_CHARS<5> << " characters long.\n";
+				return 1;
 		}
 	}
-	return true;
-}
-
-unsigned int Cursor::GetSquare() const {
-	//  NOTE: Intentional integer division
-	unsigned int sqX = _x / BASE;
-	unsigned int sqY = _y / BASE;
-
-	return (sqX + (sqY * BASE));
-}
-//-------------------------------------------------------------
 
-//-------------------------------------------------------------
-//	Reference Lists, used to quickly tell if a value is in a particular row, column, or square.
-class RefLists
-{
-public:
-	RefLists();
-	bool InitLists(const unsigned int grid[LENGTH][LENGTH]);
-	void AddValue(unsigned int value, const Cursor* cursor);
-	void RemoveValue(unsigned int value, const Cursor* cursor);
-	bool HasValue(unsigned int value, const Cursor* cursor) const;
-
-private:
-	bool _rowList[LENGTH][LENGTH];
-	bool _colList[LENGTH][LENGTH];
-	bool _sqList[LENGTH][LENGTH];
-};
-
-RefLists::RefLists()
-{
-	for (unsigned int listID = 0; listID < LENGTH; ++listID)
+	if (argc > 3 && strcmp(argv[1], "-c") == 0)
 	{
-		for (unsigned int elementID = 0; elementID < LENGTH; ++elementID)
+		unsigned long long limit = strtoull(argv[2], nullptr, 10);
+		switch (GetBaseForPuzzleLength(strlen(argv[3])))
 		{
-			_rowList[listID][elementID] = false;
-			_colList[listID][elementID] = false;
-			_sqList[listID][elementID] = false;
+			case 3:		return CountPuzzleSolutions<3>(argv[3], limit, backend);
+			case 4:		return CountPuzzleSolutions<4>(argv[3], limit, backend);
+			case 5:		return CountPuzzleSolutions<5>(argv[3], limit, backend);
+			default:
+				cerr << "Puzzles must be " << PUZZLE_CHARS<3> << ", " << PUZZLE_CHARS<4> << ", or " << PUZZLE_CHARS<5> << " characters long.\n";
+				return 1;
 		}
 	}
-}
 
-//	Adds a value to the specified Reference Lists.
-//	Returns false if value is out of range, true otherwise.
-void RefLists::AddValue(unsigned int value, const Cursor* cursor)
-{
-	//	If input value is out of range...
-	if (value < 1 || value > MAX_VALUE)
-	{
-		cout << "Attemping to modify invalid array index.\n";
-		exit(1);
-	}
-	else
+	if (argc > 2 && strcmp(argv[1], "-g") == 0)
 	{
-		//	NOTE: input values are 1, ..., MAX_VALUE, but arrays are 0, ..., MAX_VALUE - 1
-		_rowList[cursor->GetY()][value - 1] = true;
-		_colList[cursor->GetX()][value - 1] = true;
-		_sqList[cursor->GetSquare()][value - 1] = true;
+		return GeneratePuzzleLines(argc, argv);
 	}
-	
-}
 
-//	Removes a value from the specified Reference Lists.
-//	Returns false if value is out of range, true otherwise.
-void RefLists::RemoveValue(unsigned int value, const Cursor* cursor)
-{
-	//	If input value is out of range...
-	if (value < 1 || value > MAX_VALUE)
-	{
-		cout << "Attemping to modify invalid array index.\n";
-		exit(1);
-	}
-	else
+	if (argc > 1 && strcmp(argv[1], "-t") == 0)
 	{
-		//	NOTE: input values are 1, ..., MAX_VALUE, but arrays are 0, ..., MAX_VALUE - 1
-		_rowList[cursor->GetY()][value - 1] = false;
-		_colList[cursor->GetX()][value - 1] = false;
-		_sqList[cursor->GetSquare()][value - 1] = false;
+		return RunSelfChecks(backend);
 	}
-}
 
-//	Return true if value is already in one of the specified Reference Lists, false if it is thus far unique.
-bool RefLists::HasValue(unsigned int value, const Cursor* cursor) const
-{
-	//	If input value is out of range...
-	if (value < 1 || value > MAX_VALUE)
+	size_t cacheEntries = 0;
+	if (argc > 2 && strcmp(argv[1], "-k") == 0)
 	{
-		cout << "Testing invalid array index.\n";
-		exit(1);
+		cacheEntries = static_cast<size_t>(strtoull(argv[2], nullptr, 10));
+		argc -= 2;
+		argv += 2;
 	}
-	else
-	{
-		//	NOTE: input values are 1, ..., MAX_VALUE, but arrays are 0, ..., MAX_VALUE - 1
-		if (_rowList[cursor->GetY()][value - 1] ||
-			_colList[cursor->GetX()][value - 1] ||
-			_sqList[cursor->GetSquare()][value - 1])
-		{
-			return true;
-		}
-		else
-		{
-			return false;
-		}
-	}
-}
-
-//	Fills the Reference Lists with the puzzle's initial state.
-bool RefLists::InitLists(const unsigned int grid[LENGTH][LENGTH])
-{
-	Cursor cursor(LENGTH, LENGTH);
-	unsigned int curVal;
 
-	do
+	if (argc > 1)
 	{
-		curVal = grid[cursor.GetY()][cursor.GetX()];
-
-		if (curVal != 0)
+		BatchOptions options;
+		options.backend = backend;
+		options.cacheEntries = cacheEntries;
+		BatchSummary summary;
+		if (!SolveBatch(argv[1], (argc > 2) ? argv[2] : nullptr, options, summary))
 		{
-			if (!HasValue(curVal, &cursor))
-			{
-				AddValue(curVal, &cursor);
-			}
-			else
-			{
-				return false;
-			}
+			cerr << "Unable to read " << argv[1] << " or write the solutions.\n";
+			return 1;
 		}
-		
-	} while (cursor.Increment());
-
-	return true;
-}
-//-------------------------------------------------------------
 
-void SolveSudoku(unsigned int grid[LENGTH][LENGTH]);
-bool RecursivelySolve(unsigned int grid[LENGTH][LENGTH], Cursor cursor, RefLists* ref);
-bool AssignValueToCell(unsigned int grid[LENGTH][LENGTH], Cursor cursor, RefLists* ref);
-void OutputSolution(unsigned int grid[LENGTH][LENGTH]);
-
-int main(void) {
+		cerr << "Solved: " << summary.solved << ", unsolvable: " << summary.unsolvable << ", budget exhausted: " << summary.budgetExhausted << endl;
+		return 0;
+	}
 
-	unsigned int board[LENGTH][LENGTH] = {
+	Grid<3> board = { {
 		{ 0, 0, 6, 0, 1, 0, 0, 9, 2 },
 		{ 0, 0, 0, 7, 0, 0, 0, 4, 0 },
 		{ 0, 0, 0, 0, 0, 6, 0, 0, 8 },
@@ -209,103 +128,169 @@ int main(void) {
 		{ 5, 0, 0, 3, 0, 0, 0, 0, 0 },
 		{ 0, 1, 0, 0, 0, 4, 0, 0, 0 },
 		{ 9, 2, 0, 0, 8, 0, 7, 0, 0 },
-	};
+	} };
 
-	SolveSudoku(board);
+	//	Give up on any single puzzle after one second.
+	SearchLimits limits;
+	limits.deadline = chrono::steady_clock::now() + chrono::seconds(1);
+
+	OutputResult(SolveSudoku(board, limits, backend), board);
 
 	return 0;
 }
 
-void SolveSudoku(unsigned int grid[LENGTH][LENGTH])
+//	Solves one puzzle line of the given BASE, on every core if the backend supports it.
+template <unsigned int BASE>
+int SolveSinglePuzzle(const char* text, SolverBackend backend)
 {
-	if (LENGTH == 0)
+	Grid<BASE> puzzle;
+	if (!ParsePuzzle(text, strlen(text), puzzle))
 	{
-		cout << "Puzzles must have non-zero length.\n";
-		return;
+		cerr << "Puzzles may only hold '1' - '9', 'A' onwards for values above 9, '.', or '0'.\n";
+		return 1;
 	}
 
-	RefLists reference;
-	if (!reference.InitLists(grid))
-	{
-		cout << "Initial puzzle state is invalid.\n";
-		return;
-	}
+	SearchLimits limits;
+	SolveResult result = (backend == CandidateSearch) ? SolveSudokuParallel(puzzle, limits, 0) : SolveSudoku(puzzle, limits, backend);
+	OutputResult(result, puzzle);
+	return 0;
+}
 
-	Cursor cursor(LENGTH, LENGTH);
-	if (RecursivelySolve(grid, cursor, &reference))
-	{
-		OutputSolution(grid);
-	}
-	else
+//	Counts the solutions of one puzzle line of the given BASE, up to limit, and reports whether it is unique.
+template <unsigned int BASE>
+int CountPuzzleSolutions(const char* text, unsigned long long limit, SolverBackend backend)
+{
+	Grid<BASE> puzzle;
+	if (!ParsePuzzle(text, strlen(text), puzzle))
 	{
-		cout << "No solution is possible.\n";
+		cerr << "Puzzles may only hold '1' - '9', 'A' onwards for values above 9, '.', or '0'.\n";
+		return 1;
 	}
+
+	SearchLimits limits;
+	unsigned long long count;
+	SolveResult result = (backend == CandidateSearch) ? CountSolutionsParallel(puzzle, limits, limit, 0, count) : CountSolutions(puzzle, limits, limit, count, backend);
+
+	bool stoppedEarly = (result == BudgetExhausted || (limit != 0 && count == limit));
+	cout << (stoppedEarly ? "At least " : "") << count << ((count == 1) ? " solution" : " solutions");
+	cout << ((count == 1 && !stoppedEarly) ? "; the puzzle is unique.\n" : ".\n");
+	return 0;
 }
 
-//	Returns true if solution is found, false if solution is not possible.
-bool RecursivelySolve(unsigned int grid[LENGTH][LENGTH], Cursor cursor, RefLists* ref)
+//	Generates 9x9 puzzles as requested by the arguments of -g, and writes them to stdout.
+int GeneratePuzzleLines(int argc, char* argv[])
 {
-	//	Loop through cells.
-	do
+	GeneratorOptions options;
+	size_t count = static_cast<size_t>(strtoull(argv[2], nullptr, 10));
+	if (argc > 3)
 	{
-		//	If this cell is empty...
-		if (grid[cursor.GetY()][cursor.GetX()] == 0)
+		options.targetClues = static_cast<unsigned int>(strtoul(argv[3], nullptr, 10));
+	}
+	if (argc > 4)
+	{
+		const char* names[] = { "any", "easy", "medium", "hard" };
+		const PuzzleDifficulty difficulties[] = { AnyDifficulty, Easy, Medium, Hard };
+
+		bool found = false;
+		for (unsigned int i = 0; i < 4 && !found; ++i)
 		{
-			//	...and if we are unable to assign a value to that cell...
-			//		NOTE: AssignValueToCell() calls RecursivelySolve().
-			if (!AssignValueToCell(grid, cursor, ref))
+			if (strcmp(argv[4], names[i]) == 0)
 			{
-				//	...then the puzzle has no solution.
-				return false;
+				options.difficulty = difficulties[i];
+				found = true;
 			}
 		}
-	} while (cursor.Increment());
+		if (!found)
+		{
+			cerr << "Difficulty must be any, easy, medium, or hard.\n";
+			return 1;
+		}
+	}
+	if (argc > 5)
+	{
+		options.seed = strtoull(argv[5], nullptr, 10);
+	}
 
-	return true;
+	vector<Grid<3>> puzzles;
+	GeneratePuzzles(count, options, puzzles);
+
+	string lines(count * (PUZZLE_CHARS<3> + 1), '\n');
+	for (size_t i = 0; i < count; ++i)
+	{
+		FormatGrid(puzzles[i], &lines[i * (PUZZLE_CHARS<3> + 1)]);
+	}
+	cout << lines;
+	return 0;
 }
 
-//	Returns true if solution is found, false if solution is not possible.
-bool AssignValueToCell(unsigned int grid[LENGTH][LENGTH], Cursor cursor, RefLists* ref)
+//	Runs each self-check with the chosen backend.
+int RunSelfChecks(SolverBackend backend)
 {
-	//	Loop through all possible cell values (1, ..., MAX_VALUE).
-	for (unsigned int value = 1; value <= MAX_VALUE; ++value)
+	bool passed = true;
+	if (!CheckCachedInvalidGivens(backend))
 	{
-		//	If value is not in related Reference Lists...
-		if (!ref->HasValue(value, &cursor))
-		{
-			//	...add it to both the grid and those Reference Lists.
-			grid[cursor.GetY()][cursor.GetX()] = value;
-			ref->AddValue(value, &cursor);
+		cerr << "The cached solver disagrees with SolveSudoku() on a puzzle with an out-of-range given.\n";
+		passed = false;
+	}
 
-			//	Solve puzzle, starting with current position.
-			//		NOTE: RecursivelySolve() calls AssignValueToCell().
-			if (!RecursivelySolve(grid, cursor, ref))
-			{
-				//	Remove value from Reference Lists and grid, try next value of i.
-				ref->RemoveValue(value, &cursor);
-				grid[cursor.GetY()][cursor.GetX()] = 0;
-				continue;
-			}
-			else
-			{
-				//	Solution has been found.
-				return true;
-			}
+	if (passed)
+	{
+		cout << "All self-checks passed.\n";
+	}
+	return passed ? 0 : 1;
+}
+//	A given past MAX_VALUE can't come from ParsePuzzle(), but can from a caller's own grid.  The cached solver must turn it
+//	away as Unsolvable, as SolveSudoku() does, rather than canonicalize it.
+bool CheckCachedInvalidGivens(SolverBackend backend)
+{
+	Grid<3> grid = {};
+	grid[0][0] = 12;
+	grid[4][7] = 5;
+
+	Grid<3> plain = grid;
+	Grid<3> cached = grid;
+	PuzzleCache cache(1024);
+	SolveResult plainResult = SolveSudoku(plain, SearchLimits(), backend);
+	SolveResult cachedResult = SolveSudoku(cached, SearchLimits(), backend, cache);
+
+	bool unchanged = true;
+	for (unsigned int y = 0; y < LENGTH<3>; ++y)
+	{
+		for (unsigned int x = 0; x < LENGTH<3>; ++x)
+		{
+			unchanged = unchanged && cached[y][x] == grid[y][x];
 		}
 	}
 
-	//	No valid value of i found.
-	return false;
+	return plainResult == Unsolvable && cachedResult == Unsolvable && unchanged;
+}
+
+template <unsigned int BASE>
+void OutputResult(SolveResult result, const Grid<BASE>& grid)
+{
+	switch (result)
+	{
+		case Solved:
+			OutputSolution(grid);
+			break;
+		case Unsolvable:
+			cout << "No solution is possible.\n";
+			break;
+		case BudgetExhausted:
+			cout << "Search budget exhausted before a solution was found.\n";
+			break;
+	}
 }
 
-void OutputSolution(unsigned int grid[LENGTH][LENGTH])
+template <unsigned int BASE>
+void OutputSolution(const Grid<BASE>& grid)
 {
-	for (unsigned int y = 0; y < LENGTH; ++y)
+	for (unsigned int y = 0; y < LENGTH<BASE>; ++y)
 	{
-		for (unsigned int x = 0; x < LENGTH; ++x)
+		for (unsigned int x = 0; x < LENGTH<BASE>; ++x)
 		{
 			cout << grid[y][x];
-			if (x < LENGTH - 1)
+			if (x < LENGTH<BASE> - 1)
 			{
 				cout << " ";
 			}